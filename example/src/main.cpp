@@ -47,8 +47,7 @@ int main(int argc, char* argv[]){
 	test();
 	
 	// keep running until windows are closed
-	while(Window::count() != 0)
-		std::this_thread::sleep_for(10ms);
+	Window::wait_all_closed();
 	
 	return 0;
 }
@@ -61,6 +60,11 @@ void test(){
 	windows.push_back( Window::open() );
 	windows.push_back( Window::open() );
 	
+	// drag to pan, scroll to zoom
+	Window::set_allow_zoom(windows[0], true);
+	Window::set_allow_camera_movement(windows[0], true);
+	Window::set_camera_inertia(windows[0], true);
+	
 	create_gobjects();
 	loop();
 }
@@ -126,31 +130,33 @@ void create_gobjects(){
 //------------------------------------------------------------------------------
 void loop(){
 	
-	for(int i = 0; i < 100; i++){		
-		// move triangle
-		Window::set_gobj_position(
-			windows[0],
-			objects[0],
-			{200.0f + i, 200.0f + i, 0.0f}
-		);
-		
-		// rotate circle
-		Window::set_gobj_rotation(
-			windows[0],
-			objects[3],
-			i * 10
-		);
-		
-		// adjust camera
-		Window::set_camera_position(
-			windows[0],
-			{0.0f + i/2, 0.0f + i, 0.0f}
-		);
-		Window::set_camera_zoom(
-			windows[0],
-			1.0f + i * 0.01f
-		);
-		
+	// animations run on the graphics thread (one message each)
+	Window::animate_position(
+		windows[0],
+		objects[0],
+		{300.0f, 300.0f, 0.0f},
+		1.0f
+	);
+	Window::animate_rotation(
+		windows[0],
+		objects[3],
+		990.0f,
+		1.0f
+	);
+	Window::animate_camera_position(
+		windows[0],
+		{50.0f, 100.0f, 0.0f},
+		1.0f,
+		e_ease_in_out
+	);
+	Window::animate_camera_zoom(
+		windows[0],
+		2.0f,
+		1.0f,
+		e_ease_in_out
+	);
+	
+	for(int i = 0; i < 100; i++){
 		// lock stress test
 		for(int j = 0; j < 100; j++){
 			Window::add_gobject(
@@ -0,0 +1,62 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "texture_atlas.h"
+
+
+
+//------------------------------------------------------------------------------
+// embedded 5 x 7 pixel font (ASCII 32 - 126), rendered once into an image
+// that is added to the Texture_Atlas of every window showing text
+class Bitmap_Font{
+public:
+  static const std::uint64_t image_id = ~0ull;   // atlas key (never returned by the API)
+  static const std::size_t glyph_width = 5;   // font pixels
+  static const std::size_t glyph_height = 7;   // font pixels
+  static const std::size_t advance = 6;   // font pixels per character
+  static const std::size_t line_height = 9;   // font pixels per line
+  
+  static std::shared_ptr< const Image_Data > get_image();
+  static glm::vec4 get_uv_rect(char c, const Texture_Atlas::Entry& font_entry);   // u0, v0, u1, v1 of glyph
+  
+private:
+  static const std::size_t scale = 4;   // image pixels per font pixel (sharper when magnified)
+  static const std::size_t first_char = 32;
+  static const std::size_t char_count = 95;
+  static const std::size_t columns = 16;   // glyphs per row of the image
+  static const std::uint8_t glyphs[char_count][glyph_width];   // columns of 7 bits, bit 0 = top
+  
+  static std::size_t get_cell_width();
+  static std::size_t get_cell_height();
+  static std::shared_ptr< const Image_Data > render_image();
+};
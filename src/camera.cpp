@@ -79,7 +79,29 @@ void Camera::mod_zoom(float zoom_diff){
 
 
 //------------------------------------------------------------------------------
-void Camera::update(std::shared_ptr< Shader_Program > shader_program, float screen_width, float screen_height){
+float Camera::get_zoom(){
+  return zoom;
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 Camera::get_position(){
+  return position;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Camera::update(std::shared_ptr< Shader_Program > shader_program, float screen_width, float screen_height, glm::vec4 region){
+  shader_program->set_uni("view", get_view(screen_width, screen_height));
+  shader_program->set_uni("projection", get_projection(screen_width, screen_height, region));
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::mat4 Camera::get_view(float screen_width, float screen_height){
   glm::mat4 camera = glm::mat4(1.0f);
   
   // screen center
@@ -88,21 +110,26 @@ void Camera::update(std::shared_ptr< Shader_Program > shader_program, float scre
   
   // camera position
   camera = glm::translate(camera, position);
-  shader_program->set_uni("view", camera);
-  
+  return camera;
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::mat4 Camera::get_projection(float screen_width, float screen_height, glm::vec4 region){
   // camera mode
   if( ! is_ortho)
     throw std::runtime_error("Window->Camera: Perspective projection not supported!");
     
   glm::mat4 projection = glm::mat4(1.0f);
   projection = glm::ortho(
-    0.0f,
-    screen_width * zoom,
-    screen_height * zoom,
-    0.0f,
+    screen_width * zoom * region.x,
+    screen_width * zoom * region.z,
+    screen_height * zoom * region.w,
+    screen_height * zoom * region.y,
     -1.0f, 1.0f
   );
-  shader_program->set_uni("projection", projection);
+  return projection;
 }
 
 
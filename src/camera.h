@@ -49,11 +49,16 @@ public:
   void set_position(glm::vec3 pos);
   void set_zoom(float zoom);
   void mod_zoom(float zoom_diff);
+  float get_zoom();
+  glm::vec3 get_position();
   void update(
     std::shared_ptr< Shader_Program > shader_program,
     float screen_width,
-    float screen_height
+    float screen_height,
+    glm::vec4 region = {0.0f, 0.0f, 1.0f, 1.0f}   // part of the view (x0, y0, x1, y1; 0 - 1, origin top left)
   );
+  glm::mat4 get_view(float screen_width, float screen_height);
+  glm::mat4 get_projection(float screen_width, float screen_height, glm::vec4 region = {0.0f, 0.0f, 1.0f, 1.0f});
   
 private:
   glm::vec3 position = {0.0f, 0.0f, 0.0f};
@@ -0,0 +1,365 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "command_recorder.h"
+
+#include <cstring>
+#include <bit>
+#include <type_traits>
+#include <utility>
+#include <exception>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// non-member helpers
+////////////////////////////////////////////////////////////////////////////////
+
+namespace{
+
+// parameters holding live objects (promises, mappings, ...) -> not recordable
+template< typename T > struct is_handle : std::false_type{};
+template< typename T > struct is_handle< std::tuple< id, std::shared_ptr< T > > > : std::true_type{};
+
+typedef decltype(Thread_Message::parameters) msg_parameters;
+
+
+
+//------------------------------------------------------------------------------
+struct Byte_Writer{
+  std::vector< std::uint8_t >& out;
+  
+  void varint(std::uint64_t v){
+    while(v >= 0x80){
+      out.push_back( (v & 0x7F) | 0x80 );
+      v >>= 7;
+    }
+    out.push_back(v);
+  }
+  
+  void raw(const void* p, std::size_t n){
+    const std::uint8_t* bytes = (const std::uint8_t*)p;
+    out.insert(out.end(), bytes, bytes + n);
+  }
+  
+  void put(id v){  varint(v);  }
+  void put(std::size_t v){  varint(v);  }
+  void put(bool v){  out.push_back(v);  }
+  void put(int v){  varint( ((std::uint32_t)v << 1) ^ (std::uint32_t)(v >> 31) );  }   // zigzag
+  void put(float v){  raw(&v, sizeof(v));  }
+  void put(glm::vec2 v){  raw(&v, sizeof(v));  }
+  void put(glm::vec3 v){  raw(&v, sizeof(v));  }
+  
+  template< typename E > requires std::is_enum_v< E >
+  void put(E v){  varint(v);  }
+  
+  void put(const std::string& s){
+    varint(s.size());
+    raw(s.data(), s.size());
+  }
+  
+  template< typename T >   // trivially copyable elements only
+  void put(const std::vector< T >& v){
+    varint(v.size());
+    raw(v.data(), v.size() * sizeof(T));
+  }
+  
+  template< typename T >
+  void put(const std::shared_ptr< const T >& p){  put(*p);  }
+  
+  template< typename... T >
+  void put(const std::tuple< T... >& t){
+    std::apply( [&](const auto&... e){  (put(e), ...);  }, t );
+  }
+  
+  void put(const GObject_Descriptor& d){  put(d.type); put(d.position); put(d.rotation); put(d.size); put(d.colour);  }
+  void put(const Sprite_Descriptor& d){  put(d.image); put(d.position); put(d.rotation); put(d.size);  }
+  void put(const Text_Descriptor& d){  put(d.text); put(d.position); put(d.size); put(d.colour);  }
+  void put(const Tween_Descriptor& d){  put(d.property); put(d.target); put(d.duration); put(d.ease);  }
+  void put(const Image_Data& d){  put(d.width); put(d.height); put(d.pixels);  }
+  void put(const Point_Data& d){
+    put(d.first); put(d.positions); put(d.colours); put(d.sizes); put(d.default_colour); put(d.default_size);
+  }
+};
+
+
+
+//------------------------------------------------------------------------------
+struct Byte_Reader{
+  const std::vector< std::uint8_t >& in;
+  std::size_t& pos;
+  
+  void need(std::size_t n){
+    if(in.size() - pos < n)
+      throw std::runtime_error("Command_Replayer: Recording is truncated!");
+  }
+  
+  std::uint64_t varint(){
+    std::uint64_t v = 0;
+    for(int shift = 0; shift < 64; shift += 7){
+      need(1);
+      std::uint8_t byte = in[pos++];
+      v |= (std::uint64_t)(byte & 0x7F) << shift;
+      if( !(byte & 0x80) )
+        return v;
+    }
+    throw std::runtime_error("Command_Replayer: Recording is corrupt!");
+  }
+  
+  void raw(void* p, std::size_t n){
+    need(n);
+    std::memcpy(p, in.data() + pos, n);
+    pos += n;
+  }
+  
+  void get(id& v){  v = varint();  }
+  void get(std::size_t& v){  v = varint();  }
+  void get(bool& v){  need(1);  v = in[pos++];  }
+  void get(int& v){  std::uint32_t z = varint();  v = (int)((z >> 1) ^ -(z & 1));  }
+  void get(float& v){  raw(&v, sizeof(v));  }
+  void get(glm::vec2& v){  raw(&v, sizeof(v));  }
+  void get(glm::vec3& v){  raw(&v, sizeof(v));  }
+  
+  template< typename E > requires std::is_enum_v< E >
+  void get(E& v){  v = (E)varint();  }
+  
+  void get(std::string& s){
+    std::size_t n = varint();
+    need(n);
+    s.assign( (const char*)in.data() + pos, n );
+    pos += n;
+  }
+  
+  template< typename T >
+  void get(std::vector< T >& v){
+    std::size_t n = varint();
+    if(n > (in.size() - pos) / sizeof(T))   // checked before allocating
+      throw std::runtime_error("Command_Replayer: Recording is truncated!");
+    v.resize(n);
+    raw(v.data(), n * sizeof(T));
+  }
+  
+  template< typename T >
+  void get(std::shared_ptr< const T >& p){
+    auto value = std::make_shared< T >();
+    get(*value);
+    p = value;
+  }
+  
+  template< typename... T >
+  void get(std::tuple< T... >& t){
+    std::apply( [&](auto&... e){  (get(e), ...);  }, t );
+  }
+  
+  void get(GObject_Descriptor& d){  get(d.type); get(d.position); get(d.rotation); get(d.size); get(d.colour);  }
+  void get(Sprite_Descriptor& d){  get(d.image); get(d.position); get(d.rotation); get(d.size);  }
+  void get(Text_Descriptor& d){  get(d.text); get(d.position); get(d.size); get(d.colour);  }
+  void get(Tween_Descriptor& d){  get(d.property); get(d.target); get(d.duration); get(d.ease);  }
+  void get(Image_Data& d){  get(d.width); get(d.height); get(d.pixels);  }
+  void get(Point_Data& d){
+    get(d.first); get(d.positions); get(d.colours); get(d.sizes); get(d.default_colour); get(d.default_size);
+  }
+};
+
+
+
+//------------------------------------------------------------------------------
+template< std::size_t I >
+void read_alternative(Byte_Reader& reader, msg_parameters& params){
+  typedef std::variant_alternative_t< I, msg_parameters > T;
+  
+  if constexpr(is_handle< T >::value)
+    throw std::runtime_error("Command_Replayer: Recording holds a message that can't be replayed!");
+  else{
+    T value;
+    reader.get(value);
+    params = std::move(value);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+template< std::size_t... I >
+void read_parameters(Byte_Reader& reader, std::size_t index, msg_parameters& params, std::index_sequence< I... >){
+  bool found = ( (index == I  ?  (read_alternative< I >(reader, params), true)  :  false)  ||  ... );
+  if( !found)
+    throw std::runtime_error("Command_Replayer: Recording is corrupt!");
+}
+
+
+
+//------------------------------------------------------------------------------
+void check_endianness(){
+  if constexpr(std::endian::native != std::endian::little)
+    throw std::runtime_error("Recordings are only supported on little-endian machines!");
+}
+
+}   // namespace
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Command_Recorder
+////////////////////////////////////////////////////////////////////////////////
+
+Command_Recorder::Command_Recorder(const std::string& path){
+  check_endianness();
+  
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if( ! file)
+    throw std::runtime_error("Command_Recorder: Could not open " + path + "!");
+  
+  std::uint32_t file_header[2] = {version, 0};
+  file.write(magic, sizeof(magic));
+  file.write( (const char*)file_header, sizeof(file_header) );
+}
+
+
+
+//------------------------------------------------------------------------------
+Command_Recorder::~Command_Recorder(){
+  try{  flush();  }
+  catch(std::exception& e){}   // nothing left to report to
+}
+
+
+
+//------------------------------------------------------------------------------
+void Command_Recorder::record(const Thread_Message& msg, std::chrono::steady_clock::time_point time){
+  bool handle = std::visit( [](const auto& p){  return is_handle< std::decay_t< decltype(p) > >::value;  }, msg.parameters );
+  
+  std::lock_guard lock(mutex);
+  if(handle){
+    skipped++;
+    return;
+  }
+  
+  if( ! started){
+    prev_time = time;
+    started = true;
+  }
+  auto delay = std::max( time - prev_time, std::chrono::steady_clock::duration::zero() );
+  prev_time = std::max(prev_time, time);
+  
+  Byte_Writer writer{pending};
+  writer.varint( std::chrono::duration_cast< std::chrono::nanoseconds >(delay).count() );
+  pending.push_back(msg.type);
+  pending.push_back(msg.parameters.index());
+  std::visit( [&](const auto& p){
+    if constexpr( !is_handle< std::decay_t< decltype(p) > >::value )
+      writer.put(p);
+  }, msg.parameters );
+  
+  recorded++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Command_Recorder::flush(){
+  std::lock_guard file_lock(file_mutex);   // keeps concurrent flushes in order
+  
+  std::vector< std::uint8_t > bytes;
+  {
+    std::lock_guard lock(mutex);
+    std::swap(bytes, pending);
+  }
+  
+  file.write( (const char*)bytes.data(), bytes.size() );
+  file.flush();
+  if( ! file)
+    throw std::runtime_error("Command_Recorder: Writing the recording failed!");
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Command_Recorder::get_recorded(){
+  std::lock_guard lock(mutex);
+  return recorded;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Command_Recorder::get_skipped(){
+  std::lock_guard lock(mutex);
+  return skipped;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Command_Replayer
+////////////////////////////////////////////////////////////////////////////////
+
+Command_Replayer::Command_Replayer(const std::string& path){
+  check_endianness();
+  
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if( ! file)
+    throw std::runtime_error("Command_Replayer: Could not open " + path + "!");
+  
+  data.resize( file.tellg() );
+  file.seekg(0);
+  file.read( (char*)data.data(), data.size() );
+  if( ! file)
+    throw std::runtime_error("Command_Replayer: Could not read " + path + "!");
+  
+  std::uint32_t file_header[2];
+  if(data.size() < sizeof(Command_Recorder::magic) + sizeof(file_header)  ||  std::memcmp(data.data(), Command_Recorder::magic, sizeof(Command_Recorder::magic)) != 0)
+    throw std::runtime_error("Command_Replayer: " + path + " is not a recording!");
+  
+  std::memcpy(file_header, data.data() + sizeof(Command_Recorder::magic), sizeof(file_header));
+  if(file_header[0] != Command_Recorder::version)
+    throw std::runtime_error("Command_Replayer: Unsupported recording version " + std::to_string(file_header[0]) + "!");
+  
+  pos = sizeof(Command_Recorder::magic) + sizeof(file_header);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Command_Replayer::next(Thread_Message& msg, std::chrono::nanoseconds& delay){
+  if(pos == data.size())
+    return false;
+  
+  Byte_Reader reader{data, pos};
+  delay = std::chrono::nanoseconds( reader.varint() );
+  
+  reader.need(2);
+  std::uint8_t type = data[pos++];
+  std::uint8_t index = data[pos++];
+  if(type > Thread_Message::set_render_thread)
+    throw std::runtime_error("Command_Replayer: Recording is corrupt!");
+  
+  msg.type = (Thread_Message::msg_type)type;
+  read_parameters( reader, index, msg.parameters, std::make_index_sequence< std::variant_size_v< msg_parameters > >() );
+  
+  return true;
+}
@@ -0,0 +1,103 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+#include "utils.h"
+
+
+
+// used by API
+enum replay_timing{
+  r_original,   // same delays between messages as recorded
+  r_fast   // as fast as the queue accepts them
+};
+
+
+
+// used by API
+struct Replay_Stats{
+  std::size_t messages = 0;
+  double seconds = 0.0;   // from first to last message
+};
+
+
+
+// file layout (version 2, little-endian):
+//   magic "S2DREC" + 2 * '\0', uint32 version, uint32 reserved
+//   per message: varint nanoseconds since previous message, uint8 msg_type,
+//                uint8 variant index, parameters (ids & sizes as varints, floats raw)
+// messages holding handles (share_scene, pick, export_image, save/load_snapshot, capture)
+// can't be replayed and are not recorded
+
+
+
+//------------------------------------------------------------------------------
+// serializes messages in memory; the file is written by flush()
+class Command_Recorder{
+public:
+  Command_Recorder(const std::string& path);   // throws std::runtime_error
+  ~Command_Recorder();   // flushes
+  void record(const Thread_Message& msg, std::chrono::steady_clock::time_point time);   // any thread
+  void flush();   // any thread (writes recorded messages to the file)
+  std::size_t get_recorded();
+  std::size_t get_skipped();   // messages with handles
+  
+  static constexpr std::uint32_t version = 2;
+  static constexpr char magic[8] = "S2DREC";
+  
+private:
+  std::mutex mutex;
+  std::mutex file_mutex;   // only held while writing -> record() never waits for I/O
+  std::ofstream file;
+  std::vector< std::uint8_t > pending;
+  std::chrono::steady_clock::time_point prev_time;
+  bool started = false;
+  std::size_t recorded = 0;
+  std::size_t skipped = 0;
+};
+
+
+
+//------------------------------------------------------------------------------
+// reads a whole recording and hands out its messages in order
+class Command_Replayer{
+public:
+  Command_Replayer(const std::string& path);   // throws std::runtime_error
+  bool next(Thread_Message& msg, std::chrono::nanoseconds& delay);   // false at end of file (throws std::runtime_error if corrupt)
+  
+private:
+  std::vector< std::uint8_t > data;
+  std::size_t pos = 0;
+};
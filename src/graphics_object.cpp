@@ -30,6 +30,102 @@ SOFTWARE.
 #include <iostream>
 #include <exception>
 #include <math.h>
+#include <algorithm>
+#include <atomic>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GMesh public
+////////////////////////////////////////////////////////////////////////////////
+
+GMesh::GMesh(const std::vector<Vertex>& vertices, const std::vector<Index3>& indices){
+  this->vertices = vertices;
+  this->indices = indices;
+}
+
+
+
+//------------------------------------------------------------------------------
+GMesh::~GMesh(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &vertex_buffer);
+  glDeleteBuffers(1, &element_buffer);
+}
+
+
+
+//------------------------------------------------------------------------------
+void GMesh::draw(Render_Context& context){
+  if( ! buffers_ready)
+    setup_buffers(context);   // deferred until the owning window's context is current
+  
+  context.bind_vertex_array(vertex_array_object);
+  context.draw_elements(GL_TRIANGLES, index_count);
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector<Vertex>& GMesh::get_vertices(){  return vertices;  }
+
+
+
+//------------------------------------------------------------------------------
+const std::vector<Index3>& GMesh::get_indices(){  return indices;  }
+
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GMesh::get_key(){  return key;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GMesh::new_key(){
+  static std::atomic< std::uint32_t > next_key = 1;   // 0: sprites & text
+  return next_key.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GMesh private
+////////////////////////////////////////////////////////////////////////////////
+
+void GMesh::setup_buffers(Render_Context& context){
+  int buffer_size;
+  
+  // create vertex/index buffer & array object
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);   // following modifications of the buffer are 'recorded' by the array object to be repeated in render loop (?)
+  
+  // vertex buffer
+  buffer_size = vertices.size() * sizeof(Vertex);
+  glGenBuffers(1, &vertex_buffer);   // '1' = number of buffers to be created
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);   // modfying 'GL_ARRAY_BUFFER' now affects 'vertex_buffer' until new/no buffer object is bound
+  glBufferData(GL_ARRAY_BUFFER, buffer_size, vertices.data(), GL_STATIC_DRAW);   // transfer data to GPU & specify how often data will change / will be used
+  
+  // specify how data is arranged in vertex buffer
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);   // '0' = index of vertex attribute; '3' = components per vertex attribute; ... ; 'sizeof(Vertex)' = size of array element; '(void*)0' = initial offset (none)
+  glEnableVertexAttribArray(0);   // enables vertex attribte number '0'
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));   // '1' = index of vertex attribute; '3' = components per vertex attribute; ... ; 'sizeof(Vertex)' = size of array element; '(void*)sizeof(glm::vec3)' = initial offset (skip x,y,z)
+  glEnableVertexAttribArray(1);
+  
+  // index buffer
+  buffer_size = indices.size() * sizeof(Index3);
+  glGenBuffers(1, &element_buffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, buffer_size, indices.data(), GL_STATIC_DRAW);
+  
+  index_count = indices.size() * 3;
+  
+  buffers_ready = true;
+}
 
 
 
@@ -40,6 +136,8 @@ SOFTWARE.
 GObject::GObject(glm::vec3 position, float rotation){
   this->position = position;
   this->rotation = fmod(rotation, 360.0f);
+  world_position = this->position;
+  world_rotation = this->rotation;
 }
 
 
@@ -50,12 +148,117 @@ GObject::~GObject(){}
 
 
 //------------------------------------------------------------------------------
-void GObject::set_position(glm::vec3 pos){  this->position = pos;  }
+void GObject::set_position(glm::vec3 pos){
+  this->position = pos;
+  if( ! parented)
+    world_position = pos;
+  
+  unmoved_frames = 0;
+  transform_changed = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GObject::set_rotation(float rot){
+  this->rotation = fmod(rot, 360.0f);
+  if( ! parented)
+    world_rotation = this->rotation;
+  
+  unmoved_frames = 0;
+  transform_changed = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 GObject::get_position(){  return position;  }
+
+
+
+//------------------------------------------------------------------------------
+float GObject::get_rotation(){  return rotation;  }
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 GObject::get_world_position(){  return world_position;  }
+
+
+
+//------------------------------------------------------------------------------
+float GObject::get_world_rotation(){  return world_rotation;  }
+
+
+
+//------------------------------------------------------------------------------
+void GObject::set_world_transform(glm::vec3 pos, float rot){
+  world_position = pos;
+  world_rotation = rot;
+  unmoved_frames = 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GObject::set_layer(int layer){
+  this->layer = std::clamp(layer, -128, 127);
+}
+
+
+
+//------------------------------------------------------------------------------
+int GObject::get_layer(){  return layer;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint64_t GObject::get_sort_key(){
+  // layer & depth first (deterministic z-order), then state (fewer switches)
+  std::uint64_t layer_bits = layer + 128;   // 8 bits
+  std::uint64_t depth_bits = (std::clamp(world_position.z, -1.0f, 1.0f) + 1.0f) / 2.0f * 0xFFFF;   // 16 bits (same range as projection)
+  std::uint64_t program_bits = get_program();   // 8 bits
+  std::uint64_t mesh_bits = get_mesh_key();   // 32 bits
+  
+  return layer_bits << 56 | depth_bits << 40 | program_bits << 32 | mesh_bits;
+}
+
+
+
+//------------------------------------------------------------------------------
+program_type GObject::get_program(){  return p_shape;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GObject::get_mesh_key(){
+  return own_mesh_key;   // own vertex array
+}
+
+
+
+//------------------------------------------------------------------------------
+batch_type GObject::get_batch_type(){  return b_none;  }
+
+
+
+//------------------------------------------------------------------------------
+void GObject::set_size(float){}
+
+
+
+//------------------------------------------------------------------------------
+float GObject::get_size(){  return 1.0f;  }
+
+
+
+//------------------------------------------------------------------------------
+void GObject::set_colour(glm::vec3){}
 
 
 
 //------------------------------------------------------------------------------
-void GObject::set_rotation(float rot){  this->rotation = fmod(rot, 360.0f);  }
+glm::vec3 GObject::get_colour(){  return glm::vec3(0.0f, 0.0f, 0.0f);  }
 
 
 
@@ -83,74 +286,142 @@ GShape::GShape(
 
 
 //------------------------------------------------------------------------------
-GShape::~GShape(){
-  glDeleteVertexArrays(1, &vertex_array_object);
-  glDeleteBuffers(1, &vertex_buffer);
-  glDeleteBuffers(1, &element_buffer);
+GShape::GShape(
+  glm::vec3 position,
+  float rotation,
+  float size,
+  glm::vec3 colour,
+  std::shared_ptr<GMesh> mesh)
+  : GObject(position, rotation){
+    
+    this->size = size;
+    this->colour = colour;
+    this->mesh = mesh;
 }
 
 
 
 //------------------------------------------------------------------------------
-void GShape::render(std::shared_ptr<Shader_Program> shader_program){
-  if( ! buffers_ready)
-    setup_buffers();
+GShape::~GShape(){}
+
+
+
+//------------------------------------------------------------------------------
+void GShape::render(Render_Context& context){
+  auto shader_program = context.use_program(p_shape);
   
   model_transformation(shader_program);
+  shader_program->set_uni("uni_color", colour.x, colour.y, colour.z, 0.0f);
   
-  glBindVertexArray(vertex_array_object);
-  glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, 0);
+  get_mesh()->draw(context);
 }
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-// GShape private
-////////////////////////////////////////////////////////////////////////////////
-
-void GShape::setup_buffers(){
-  int buffer_size;
-  
-  // create vertex/index buffer & array object
-  glGenVertexArrays(1, &vertex_array_object);
-  glBindVertexArray(vertex_array_object);   // following modifications of the buffer are 'recorded' by the array object to be repeated in render loop (?)
+//------------------------------------------------------------------------------
+void GShape::bake(std::vector<Vertex>& vertices, std::vector<Index3>& indices){
+  const std::vector<Vertex>& src_vertices = mesh ? mesh->get_vertices() : this->vertices;
+  const std::vector<Index3>& src_indices = mesh ? mesh->get_indices() : this->indices;
   
-  // vertex buffer
-  buffer_size = vertices.size() * sizeof(Vertex);
-  glGenBuffers(1, &vertex_buffer);   // '1' = number of buffers to be created
-  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);   // modfying 'GL_ARRAY_BUFFER' now affects 'vertex_buffer' until new/no buffer object is bound
-  glBufferData(GL_ARRAY_BUFFER, buffer_size, vertices.data(), GL_STATIC_DRAW);   // transfer data to GPU & specify how often data will change / will be used
+  // same transformation as model_transformation() & shader, done on the CPU
+  float c = cos( glm::radians(world_rotation) );
+  float s = sin( glm::radians(world_rotation) );
+  uint offset = vertices.size();
   
-  // specify how data is arranged in vertex buffer
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);   // '0' = index of vertex attribute; '3' = components per vertex attribute; ... ; 'sizeof(Vertex)' = size of array element; '(void*)0' = initial offset (none)
-  glEnableVertexAttribArray(0);   // enables vertex attribte number '0'
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));   // '1' = index of vertex attribute; '3' = components per vertex attribute; ... ; 'sizeof(Vertex)' = size of array element; '(void*)sizeof(glm::vec3)' = initial offset (skip x,y,z)
-  glEnableVertexAttribArray(1);
-  
-  // index buffer
-  buffer_size = indices.size() * sizeof(Index3);
-  glGenBuffers(1, &element_buffer);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, buffer_size, indices.data(), GL_STATIC_DRAW);
+  for(const auto &v : src_vertices){
+    float x = v.position.x * size;
+    float y = v.position.y * size;
+    
+    vertices.push_back({
+      {world_position.x + c * x - s * y, world_position.y + s * x + c * y, world_position.z + v.position.z},
+      {v.colour.x + colour.x, v.colour.y + colour.y, v.colour.z + colour.z}
+    });
+  }
   
-  index_count = indices.size() * 3;
+  for(const auto &i : src_indices)
+    indices.push_back( {i.a + offset, i.b + offset, i.c + offset} );
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::shared_ptr<GMesh>& GShape::get_mesh(){
+  if( ! mesh){
+    mesh = std::make_shared<GMesh>(vertices, indices);
+    vertices.clear();
+    indices.clear();
+  }
   
-  // cleanup
-  vertices.clear();
-  indices.clear();
-  buffers_ready = true;
+  return mesh;
 }
 
 
 
 //------------------------------------------------------------------------------
-void GShape::model_transformation(std::shared_ptr<Shader_Program> shader_program){
+glm::mat4 GShape::get_model_matrix(){
   glm::mat4 mtrans = glm::mat4(1.0f);
   
-  mtrans = glm::translate(mtrans, position);
-  mtrans = glm::rotate(mtrans, glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+  mtrans = glm::translate(mtrans, world_position);
+  mtrans = glm::rotate(mtrans, glm::radians(world_rotation), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+  mtrans = glm::scale(mtrans, glm::vec3(size, size, 1.0f));
+  
+  return mtrans;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GShape::set_size(float size){
+  this->size = size;
+  unmoved_frames = 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+float GShape::get_size(){  return size;  }
+
+
+
+//------------------------------------------------------------------------------
+void GShape::set_colour(glm::vec3 colour){
+  this->colour = colour;
+  unmoved_frames = 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 GShape::get_colour(){  return colour;  }
+
+
+
+//------------------------------------------------------------------------------
+program_type GShape::get_program(){  return p_shape_batch;  }
+
+
+
+//------------------------------------------------------------------------------
+batch_type GShape::get_batch_type(){  return b_shape;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GShape::get_mesh_key(){
+  if( ! mesh)
+    return GObject::get_mesh_key();
   
-  shader_program->set_uni("model", mtrans);
+  return mesh->get_key();   // shared vertex array
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GShape private
+////////////////////////////////////////////////////////////////////////////////
+
+void GShape::model_transformation(std::shared_ptr<Shader_Program> shader_program){
+  shader_program->set_uni("model", get_model_matrix());
 }
 
 
@@ -202,6 +473,14 @@ GTriangle::~GTriangle(){}
 
 
 
+//------------------------------------------------------------------------------
+std::shared_ptr<GMesh> GTriangle::new_unit_mesh(){
+  GTriangle unit(1.0f, {0.0f, 0.0f, 0.0f});
+  return std::make_shared<GMesh>(unit.vertices, unit.indices);
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // GTriangle private
 ////////////////////////////////////////////////////////////////////////////////
@@ -269,6 +548,14 @@ GRect::~GRect(){}
 
 
 
+//------------------------------------------------------------------------------
+std::shared_ptr<GMesh> GRect::new_unit_mesh(){
+  GRect unit(1.0f, {0.0f, 0.0f, 0.0f});
+  return std::make_shared<GMesh>(unit.vertices, unit.indices);
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // GRect private
 ////////////////////////////////////////////////////////////////////////////////
@@ -334,6 +621,14 @@ GCircle::~GCircle(){}
 
 
 
+//------------------------------------------------------------------------------
+std::shared_ptr<GMesh> GCircle::new_unit_mesh(){
+  GCircle unit(1.0f, {0.0f, 0.0f, 0.0f});
+  return std::make_shared<GMesh>(unit.vertices, unit.indices);
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // GCircle private
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +29,7 @@ SOFTWARE.
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 ///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
 // #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
@@ -39,6 +40,7 @@ SOFTWARE.
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "shader_program.h"
+#include "render_context.h"
 
 
 
@@ -55,20 +57,81 @@ struct Index3{
 
 
 
+// graphics_objects of one batch_type can be drawn together (see Window::Wrapper)
+enum batch_type{
+  b_none,
+  b_shape,
+  b_sprite,
+  b_text
+};
+
+
+
+//------------------------------------------------------------------------------
+// vertex data on the GPU; may be shared by any number of GShapes of one window
+class GMesh{
+public:
+  GMesh(
+    const std::vector<Vertex>& vertices,
+    const std::vector<Index3>& indices
+  );
+  ~GMesh();
+  void draw(Render_Context& context);   // graphics thread (context of owning window has to be current)
+  const std::vector<Vertex>& get_vertices();
+  const std::vector<Index3>& get_indices();
+  std::uint32_t get_key();
+  static std::uint32_t new_key();   // unique per vertex array, in creation order (stable across runs, unlike addresses)
+  
+protected:
+  GLuint vertex_buffer, vertex_array_object, element_buffer;
+  std::vector<Vertex> vertices;   // kept after upload (needed for baking)
+  std::vector<Index3> indices;   // kept after upload (needed for baking)
+  std::size_t index_count;
+  bool buffers_ready = false;
+  std::uint32_t key = new_key();
+  
+  void setup_buffers(Render_Context& context);
+};
+
+
+
 //------------------------------------------------------------------------------
 class GObject{
 public:
   GObject() = default;
   GObject(glm::vec3 position, float rotation);
-  ~GObject();
+  virtual ~GObject();
   void set_position(glm::vec3 pos);
   void set_rotation(float rot);
+  void set_layer(int layer);
+  int get_layer();
+  glm::vec3 get_position();   // relative to parent (if any)
+  float get_rotation();   // relative to parent (if any)
+  glm::vec3 get_world_position();
+  float get_world_rotation();
+  void set_world_transform(glm::vec3 pos, float rot);   // only used by Transform_Hierarchy
+  std::uint64_t get_sort_key();   // layer | depth | program | mesh
+  virtual void set_size(float size);   // ignored by objects without size
+  virtual float get_size();
+  virtual void set_colour(glm::vec3 colour);   // ignored by objects without colour
+  virtual glm::vec3 get_colour();
+  
+  virtual void render(Render_Context& context) = 0;   // don't use this! (only intended for Window::Wrapper)
+  virtual program_type get_program();
+  virtual std::uint32_t get_mesh_key();   // objects with equal keys share a vertex array
+  virtual batch_type get_batch_type();
   
-  virtual void render(std::shared_ptr<Shader_Program> shader_program) = 0;   // don't use this! (only intended for Window::Wrapper)
+  std::size_t unmoved_frames = 0;   // only used by Window::Wrapper
+  bool parented = false;   // only used by Transform_Hierarchy (world transform is set by hierarchy)
+  bool transform_changed = false;   // only used by Transform_Hierarchy
   
 protected:
   glm::vec3 position = {0.0f, 0.0f, 0.0f};
   float rotation = 0.0f;  // degrees
+  glm::vec3 world_position = {0.0f, 0.0f, 0.0f};   // used for rendering
+  float world_rotation = 0.0f;   // used for rendering
+  int layer = 0;   // [-128, 127]; higher layers are drawn on top
+  std::uint32_t own_mesh_key = GMesh::new_key();   // for objects with their own vertex array
 };
 
 
@@ -82,18 +145,34 @@ public:
     const std::vector<Vertex>& vertices,
     const std::vector<Index3>& indices
   );
+  GShape(
+    glm::vec3 position,
+    float rotation,
+    float size,
+    glm::vec3 colour,
+    std::shared_ptr<GMesh> mesh
+  );
   ~GShape();
   
-  virtual void render(std::shared_ptr<Shader_Program> shader_program);   // don't use this! (only intended for Window::Wrapper)
+  virtual void render(Render_Context& context);   // don't use this! (only intended for Window::Wrapper)
+  void bake(std::vector<Vertex>& vertices, std::vector<Index3>& indices);   // appends transformed geometry
+  const std::shared_ptr<GMesh>& get_mesh();   // graphics thread (creates mesh on first call; afterwards safe from jobs)
+  glm::mat4 get_model_matrix();
+  virtual void set_size(float size);
+  virtual float get_size();
+  virtual void set_colour(glm::vec3 colour);
+  virtual glm::vec3 get_colour();
+  virtual program_type get_program();
+  virtual std::uint32_t get_mesh_key();
+  virtual batch_type get_batch_type();
   
 protected:
-  GLuint vertex_buffer, vertex_array_object, element_buffer;
+  std::shared_ptr<GMesh> mesh;   // created from 'vertices' & 'indices' on first render, if not shared
   std::vector<Vertex> vertices;
   std::vector<Index3> indices;
-  std::size_t index_count;
-  bool buffers_ready = false;
+  float size = 1.0f;   // scales the mesh (shared meshes have unit size)
+  glm::vec3 colour = {0.0f, 0.0f, 0.0f};   // added to vertex colours (shared meshes are black)
   
-  virtual void setup_buffers();
   virtual void model_transformation(std::shared_ptr<Shader_Program> shader_program);
 };
 
@@ -128,6 +207,8 @@ public:
   );
   ~GTriangle();
   
+  static std::shared_ptr<GMesh> new_unit_mesh();   // size 1, black
+  
 protected:
   std::vector<Index3> tri_index = {{0, 1, 2}};
   
@@ -165,6 +246,8 @@ public:
   );
   ~GRect();
   
+  static std::shared_ptr<GMesh> new_unit_mesh();   // size 1, black
+  
 protected:
   std::vector<Index3> rect_index = {{0, 1, 2}, {1, 2, 3}};
   
@@ -204,6 +287,8 @@ public:
   );
   ~GCircle();
   
+  static std::shared_ptr<GMesh> new_unit_mesh();   // size 1, black
+  
 protected:
   uint vertex_count = 16;
   
@@ -0,0 +1,225 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "graphics_point_set.h"
+
+#include <exception>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+
+// buffer layout: [positions][colours][sizes] (colours & sizes only if given on creation)
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GPoint_Set public
+////////////////////////////////////////////////////////////////////////////////
+
+GPoint_Set::GPoint_Set(std::shared_ptr<const Point_Data> data)
+  : GObject({0.0f, 0.0f, 0.0f}, 0.0f){
+    
+    count = data->positions.size();
+    has_colours = ! data->colours.empty();
+    has_sizes = ! data->sizes.empty();
+    default_colour = data->default_colour;
+    default_size = data->default_size;
+    
+    if(has_colours && data->colours.size() != count)
+      throw std::runtime_error("Could not create GPoint_Set! (Colour count != position count)");
+    if(has_sizes && data->sizes.size() != count)
+      throw std::runtime_error("Could not create GPoint_Set! (Size count != position count)");
+    
+    pending.push_back(data);   // shared with the message -> no copy
+}
+
+
+
+//------------------------------------------------------------------------------
+GPoint_Set::~GPoint_Set(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &vertex_buffer);
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPoint_Set::update(std::shared_ptr<const Point_Data> data){
+  pending.push_back(data);
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPoint_Set::render(Render_Context& context){
+  if( ! buffers_ready)
+    setup_buffers(context);
+  
+  for(const auto &p : pending)
+    upload(*p);
+  pending.clear();
+  
+  auto shader_program = context.use_program(p_point_set);
+  model_transformation(shader_program);
+  shader_program->set_uni("pixels_per_unit", context.get_pixels_per_unit());
+  
+  context.bind_vertex_array(vertex_array_object);
+  
+  // constant attributes are not part of the vertex array object
+  if( ! has_colours)
+    glVertexAttrib3f(1, default_colour.x, default_colour.y, default_colour.z);
+  if( ! has_sizes)
+    glVertexAttrib1f(2, default_size);
+  
+  context.draw_arrays(GL_POINTS, 0, count);
+}
+
+
+
+//------------------------------------------------------------------------------
+program_type GPoint_Set::get_program(){  return p_point_set;  }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GPoint_Set private
+////////////////////////////////////////////////////////////////////////////////
+
+void GPoint_Set::setup_buffers(Render_Context& context){
+  std::size_t colour_offset = count * sizeof(glm::vec2);
+  std::size_t size_offset = colour_offset + (has_colours ? count * sizeof(glm::vec3) : 0);
+  std::size_t buffer_size = size_offset + (has_sizes ? count * sizeof(float) : 0);
+  
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);
+  
+  glGenBuffers(1, &vertex_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, buffer_size, NULL, GL_DYNAMIC_DRAW);   // filled by upload()
+  
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+  glEnableVertexAttribArray(0);
+  
+  if(has_colours){
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)colour_offset);
+    glEnableVertexAttribArray(1);
+  }
+  
+  if(has_sizes){
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)size_offset);
+    glEnableVertexAttribArray(2);
+  }
+  
+  glEnable(GL_PROGRAM_POINT_SIZE);   // point size is set by vertex shader
+  
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPoint_Set::upload(const Point_Data& data){
+  if(data.first >= count)
+    return;
+  
+  std::size_t colour_offset = count * sizeof(glm::vec2);
+  std::size_t size_offset = colour_offset + (has_colours ? count * sizeof(glm::vec3) : 0);
+  std::size_t available = count - data.first;
+  
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  
+  std::size_t n = std::min(data.positions.size(), available);
+  if(n > 0)
+    glBufferSubData(GL_ARRAY_BUFFER, data.first * sizeof(glm::vec2), n * sizeof(glm::vec2), data.positions.data());
+  
+  n = std::min(data.colours.size(), available);
+  if(has_colours && n > 0)
+    glBufferSubData(GL_ARRAY_BUFFER, colour_offset + data.first * sizeof(glm::vec3), n * sizeof(glm::vec3), data.colours.data());
+  
+  n = std::min(data.sizes.size(), available);
+  if(has_sizes && n > 0)
+    glBufferSubData(GL_ARRAY_BUFFER, size_offset + data.first * sizeof(float), n * sizeof(float), data.sizes.data());
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPoint_Set::model_transformation(std::shared_ptr<Shader_Program> shader_program){
+  glm::mat4 mtrans = glm::mat4(1.0f);
+  
+  mtrans = glm::translate(mtrans, world_position);
+  mtrans = glm::rotate(mtrans, glm::radians(world_rotation), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+  
+  shader_program->set_uni("model", mtrans);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// shaders
+////////////////////////////////////////////////////////////////////////////////
+
+const std::string GPoint_Set::vert_shader = 
+  "#version 450 core\n"
+  "\n"
+  "layout (location = 0) in vec2 in_pos;\n"
+  "layout (location = 1) in vec3 in_color;\n"
+  "layout (location = 2) in float in_size;   // diameter in world units\n"
+  "\n"
+  "out vec4 vertex_color;\n"
+  "\n"
+  "uniform mat4 model;\n"
+  "uniform mat4 view;\n"
+  "uniform mat4 projection;\n"
+  "uniform float pixels_per_unit;\n"
+  "\n"
+  "void main(){\n"
+  "  gl_Position = projection * view * model * vec4(in_pos, 0.0f, 1.0f);\n"
+  "  gl_PointSize = max(in_size * pixels_per_unit, 1.0f);\n"
+  "  vertex_color = vec4(in_color, 1.0f);\n"
+  "}";
+
+
+
+//------------------------------------------------------------------------------
+const std::string GPoint_Set::frag_shader = 
+  "#version 450 core\n"
+  "\n"
+  "in vec4 vertex_color;\n"
+  "out vec4 frag_color;\n"
+  "\n"
+  "void main(){\n"
+  "  vec2 p = gl_PointCoord * 2.0f - 1.0f;\n"
+  "  if(dot(p, p) > 1.0f)   // outside of circle\n"
+  "    discard;\n"
+  "  frag_color = vertex_color;\n"
+  "}";
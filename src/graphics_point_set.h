@@ -0,0 +1,85 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "shader_program.h"
+#include "render_context.h"
+#include "graphics_object.h"
+
+
+
+// point data as passed from the API to the graphics thread
+struct Point_Data{
+  std::size_t first = 0;   // index of first point to be updated (0 on creation)
+  std::vector<glm::vec2> positions;
+  std::vector<glm::vec3> colours;   // empty -> default colour
+  std::vector<float> sizes;   // empty -> default size
+  glm::vec3 default_colour = {1.0f, 1.0f, 1.0f};
+  float default_size = 1.0f;
+};
+
+
+
+//------------------------------------------------------------------------------
+// scatter plot: any number of round points in a single buffer & draw call
+class GPoint_Set: public GObject{
+public:
+  GPoint_Set(std::shared_ptr<const Point_Data> data);
+  ~GPoint_Set();
+  void update(std::shared_ptr<const Point_Data> data);   // graphics thread
+  
+  virtual void render(Render_Context& context);   // don't use this! (only intended for Window::Wrapper)
+  virtual program_type get_program();
+  
+  static const std::string vert_shader;
+  static const std::string frag_shader;
+  
+protected:
+  GLuint vertex_buffer, vertex_array_object;
+  bool buffers_ready = false;
+  std::size_t count;
+  bool has_colours;
+  bool has_sizes;
+  glm::vec3 default_colour;
+  float default_size;
+  std::vector< std::shared_ptr<const Point_Data> > pending;   // uploaded on next render
+  
+  void setup_buffers(Render_Context& context);
+  void upload(const Point_Data& data);
+  void model_transformation(std::shared_ptr<Shader_Program> shader_program);
+};
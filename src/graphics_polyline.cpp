@@ -0,0 +1,203 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "graphics_polyline.h"
+
+#include <exception>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+
+
+// The GPU buffer holds every point twice ('capacity' slots + 'capacity' mirror
+// slots), so the visible points always form one contiguous range that can be
+// drawn as a single triangle strip (2 vertices per point).
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GPolyline public
+////////////////////////////////////////////////////////////////////////////////
+
+GPolyline::GPolyline(float thickness, glm::vec3 colour, std::size_t capacity)
+  : GObject({0.0f, 0.0f, 0.0f}, 0.0f){
+    
+    if(capacity < 2  ||  capacity > max_capacity)
+      throw std::runtime_error("Could not create GPolyline! (Invalid capacity)");
+    
+    this->thickness = thickness;
+    this->colour = colour;
+    this->capacity = capacity;
+    points.resize(capacity);
+}
+
+
+
+//------------------------------------------------------------------------------
+GPolyline::~GPolyline(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &vertex_buffer);
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPolyline::append_points(const std::vector<glm::vec2>& new_points){
+  if(new_points.empty())
+    return;
+  
+  // previous last point has to be re-extruded (its normal depends on its successor)
+  if(total > 0)
+    first_dirty = std::min(first_dirty, total - 1);
+  
+  for(const auto &p : new_points){
+    points[total % capacity] = p;
+    total++;
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPolyline::render(Render_Context& context){
+  if( ! buffers_ready)
+    setup_buffers(context);
+  
+  upload_dirty_points();
+  
+  std::size_t visible = std::min(total, capacity);
+  if(visible < 2)
+    return;
+  
+  auto shader_program = context.use_program(p_shape);
+  model_transformation(shader_program);
+  shader_program->set_uni("uni_color", 0.0f, 0.0f, 0.0f, 0.0f);
+  
+  std::size_t first_slot = (total - visible) % capacity;
+  context.bind_vertex_array(vertex_array_object);
+  context.draw_arrays(GL_TRIANGLE_STRIP, first_slot * 2, visible * 2);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// GPolyline private
+////////////////////////////////////////////////////////////////////////////////
+
+void GPolyline::setup_buffers(Render_Context& context){
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);
+  
+  // vertex buffer (allocated once, only ever partially updated)
+  GLsizeiptr buffer_size = 2 * capacity * 2 * sizeof(Vertex);   // ring + mirror, 2 vertices per point
+  glGenBuffers(1, &vertex_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, buffer_size, NULL, GL_DYNAMIC_DRAW);
+  
+  // same layout as GMesh
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
+  glEnableVertexAttribArray(1);
+  
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPolyline::upload_dirty_points(){
+  std::size_t oldest = total - std::min(total, capacity);
+  std::size_t first = std::max(first_dirty, oldest);   // rolled off points don't need uploading
+  if(first >= total)
+    return;
+  
+  // extrude new points, split at the end of the ring
+  std::vector<Vertex> data;
+  std::size_t start_slot = first % capacity;
+  
+  for(std::size_t p = first; p < total; p++){
+    if(p % capacity == 0 && ! data.empty()){
+      upload_slots(start_slot, data);
+      data.clear();
+      start_slot = 0;
+    }
+    
+    glm::vec2 pos = points[p % capacity];
+    glm::vec2 offset = get_normal(p) * thickness / 2.0f;
+    data.push_back( {{pos.x + offset.x, pos.y + offset.y, 0.0f}, colour} );
+    data.push_back( {{pos.x - offset.x, pos.y - offset.y, 0.0f}, colour} );
+  }
+  upload_slots(start_slot, data);
+  
+  first_dirty = total;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPolyline::upload_slots(std::size_t slot, const std::vector<Vertex>& data){
+  GLsizeiptr size = data.size() * sizeof(Vertex);
+  GLintptr offset = slot * 2 * sizeof(Vertex);
+  GLintptr mirror_offset = (slot + capacity) * 2 * sizeof(Vertex);
+  
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferSubData(GL_ARRAY_BUFFER, offset, size, data.data());
+  glBufferSubData(GL_ARRAY_BUFFER, mirror_offset, size, data.data());
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec2 GPolyline::get_normal(std::size_t point){
+  std::size_t oldest = total - std::min(total, capacity);
+  glm::vec2 prev = points[ (point > oldest ? point - 1 : point) % capacity ];
+  glm::vec2 next = points[ (point + 1 < total ? point + 1 : point) % capacity ];
+  
+  glm::vec2 direction = next - prev;   // central difference -> normal bisects corners
+  float length = glm::length(direction);
+  if(length == 0.0f)
+    return {0.0f, 1.0f};
+  
+  return {- direction.y / length, direction.x / length};
+}
+
+
+
+//------------------------------------------------------------------------------
+void GPolyline::model_transformation(std::shared_ptr<Shader_Program> shader_program){
+  glm::mat4 mtrans = glm::mat4(1.0f);
+  
+  mtrans = glm::translate(mtrans, world_position);
+  mtrans = glm::rotate(mtrans, glm::radians(world_rotation), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+  
+  shader_program->set_uni("model", mtrans);
+}
@@ -0,0 +1,74 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <limits>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "shader_program.h"
+#include "render_context.h"
+#include "graphics_object.h"
+
+
+
+//------------------------------------------------------------------------------
+// line strip with a fixed capacity; appended points are written into a GPU
+// ring buffer, the oldest points roll off once the capacity is reached
+class GPolyline: public GObject{
+public:
+  GPolyline(float thickness, glm::vec3 colour, std::size_t capacity);   // capacity in [2, max_capacity]
+  ~GPolyline();
+  void append_points(const std::vector<glm::vec2>& new_points);   // graphics thread
+  
+  virtual void render(Render_Context& context);   // don't use this! (only intended for Window::Wrapper)
+  
+  static constexpr std::size_t max_capacity = std::numeric_limits<GLint>::max() / 4;   // ring + mirror, 2 vertices per point -> vertex index fits GLint
+  
+protected:
+  GLuint vertex_buffer, vertex_array_object;
+  bool buffers_ready = false;
+  float thickness;
+  glm::vec3 colour;
+  std::size_t capacity;   // points
+  std::vector<glm::vec2> points;   // CPU copy of the ring (needed for extrusion)
+  std::size_t total = 0;   // points ever appended
+  std::size_t first_dirty = 0;   // first point not yet (correctly) uploaded
+  
+  void setup_buffers(Render_Context& context);
+  void upload_dirty_points();
+  void upload_slots(std::size_t slot, const std::vector<Vertex>& data);
+  glm::vec2 get_normal(std::size_t point);
+  void model_transformation(std::shared_ptr<Shader_Program> shader_program);
+};
@@ -0,0 +1,80 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "graphics_sprite.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+GSprite::GSprite(std::uint64_t image_id, glm::vec3 position, float rotation, float size)
+  : GObject(position, rotation){
+    
+    this->image_id = image_id;
+    this->size = size;
+}
+
+
+
+//------------------------------------------------------------------------------
+GSprite::~GSprite(){}
+
+
+
+//------------------------------------------------------------------------------
+std::uint64_t GSprite::get_image(){  return image_id;  }
+
+
+
+//------------------------------------------------------------------------------
+void GSprite::set_size(float size){  this->size = size;  }
+
+
+
+//------------------------------------------------------------------------------
+float GSprite::get_size(){  return size;  }
+
+
+
+//------------------------------------------------------------------------------
+void GSprite::render(Render_Context&){}
+
+
+
+//------------------------------------------------------------------------------
+program_type GSprite::get_program(){  return p_sprite;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GSprite::get_mesh_key(){  return 0;  }   // all sprites share one vertex array
+
+
+
+//------------------------------------------------------------------------------
+batch_type GSprite::get_batch_type(){  return b_sprite;  }
@@ -0,0 +1,56 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "graphics_object.h"
+
+
+
+//------------------------------------------------------------------------------
+// image from the window's Texture_Atlas on a quad; drawn by Sprite_Batch
+class GSprite: public GObject{
+public:
+  GSprite(std::uint64_t image_id, glm::vec3 position, float rotation, float size);
+  ~GSprite();
+  std::uint64_t get_image();
+  virtual void set_size(float size);
+  virtual float get_size();
+  
+  virtual void render(Render_Context& context);   // don't use this! (sprites are drawn by Sprite_Batch)
+  virtual program_type get_program();
+  virtual std::uint32_t get_mesh_key();
+  virtual batch_type get_batch_type();
+  
+protected:
+  std::uint64_t image_id;
+  float size;   // width in world units (height keeps aspect ratio of image)
+};
@@ -0,0 +1,158 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "graphics_text.h"
+
+#include "bitmap_font.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+GText::GText(const std::string& text, glm::vec3 position, float size, glm::vec3 colour)
+  : GObject(position, 0.0f){
+    
+    this->text = text;
+    this->size = size;
+    this->colour = colour;
+}
+
+
+
+//------------------------------------------------------------------------------
+GText::~GText(){}
+
+
+
+//------------------------------------------------------------------------------
+void GText::set_text(const std::string& text){
+  if(text == this->text)
+    return;
+  
+  this->text = text;
+  dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector<GText::Glyph>& GText::get_glyphs(const Texture_Atlas::Entry& font_entry){
+  if(dirty)
+    layout(font_entry);
+  
+  return glyphs;
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec2 GText::get_glyph_half_size(){
+  float pixel = size / Bitmap_Font::glyph_height;
+  return glm::vec2(Bitmap_Font::glyph_width, Bitmap_Font::glyph_height) * pixel * 0.5f;
+}
+
+
+
+//------------------------------------------------------------------------------
+void GText::set_size(float size){
+  this->size = size;
+  dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+float GText::get_size(){  return size;  }
+
+
+
+//------------------------------------------------------------------------------
+void GText::set_colour(glm::vec3 colour){  this->colour = colour;  }
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 GText::get_colour(){  return colour;  }
+
+
+
+//------------------------------------------------------------------------------
+void GText::render(Render_Context&){}
+
+
+
+//------------------------------------------------------------------------------
+program_type GText::get_program(){  return p_sprite;  }
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t GText::get_mesh_key(){  return 0;  }   // same vertex array as sprites
+
+
+
+//------------------------------------------------------------------------------
+batch_type GText::get_batch_type(){  return b_text;  }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void GText::layout(const Texture_Atlas::Entry& font_entry){
+  float pixel = size / Bitmap_Font::glyph_height;
+  glm::vec2 half_size = get_glyph_half_size();
+  
+  glyphs.clear();
+  glyphs.reserve(text.size());
+  
+  // position = top left of first line; lines grow downward (y-down camera)
+  std::size_t column = 0;
+  std::size_t line = 0;
+  for(char c : text){
+    if(c == '\n'){
+      column = 0;
+      line++;
+      continue;
+    }
+    
+    if(c != ' '){
+      Glyph glyph;
+      glyph.offset = glm::vec2(
+        column * Bitmap_Font::advance * pixel + half_size.x,
+        half_size.y + (float)(line * Bitmap_Font::line_height) * pixel
+      );
+      glyph.uv_rect = Bitmap_Font::get_uv_rect(c, font_entry);
+      glyphs.push_back(glyph);
+    }
+    column++;
+  }
+  
+  dirty = false;
+}
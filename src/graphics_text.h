@@ -0,0 +1,73 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "graphics_object.h"
+#include "texture_atlas.h"
+
+
+
+//------------------------------------------------------------------------------
+// text label (Bitmap_Font); glyph quads are drawn by Sprite_Batch
+class GText: public GObject{
+public:
+  struct Glyph{
+    glm::vec2 offset;   // centre relative to label position (unrotated)
+    glm::vec4 uv_rect;
+  };
+  
+  GText(const std::string& text, glm::vec3 position, float size, glm::vec3 colour);
+  ~GText();
+  void set_text(const std::string& text);
+  const std::vector<Glyph>& get_glyphs(const Texture_Atlas::Entry& font_entry);   // graphics thread (lays out text if changed)
+  glm::vec2 get_glyph_half_size();
+  virtual void set_size(float size);
+  virtual float get_size();
+  virtual void set_colour(glm::vec3 colour);
+  virtual glm::vec3 get_colour();
+  
+  virtual void render(Render_Context& context);   // don't use this! (labels are drawn by Sprite_Batch)
+  virtual program_type get_program();
+  virtual std::uint32_t get_mesh_key();
+  virtual batch_type get_batch_type();
+  
+protected:
+  std::string text;
+  float size;   // glyph height in world units
+  glm::vec3 colour;
+  std::vector<Glyph> glyphs;
+  bool dirty = true;   // text/size changed since last layout
+  
+  void layout(const Texture_Atlas::Entry& font_entry);
+};
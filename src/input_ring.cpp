@@ -0,0 +1,85 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "input_ring.h"
+
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+
+Input_Ring::Input_Ring(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+Input_Ring::~Input_Ring(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Input_Ring::push(const Input_Event& event){
+  std::size_t h = head.load(std::memory_order_relaxed);
+  if(h - tail.load(std::memory_order_acquire) == capacity){
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  
+  events[h & (capacity - 1)] = event;
+  head.store(h + 1, std::memory_order_release);
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Input_Ring::pop(std::span< Input_Event > out){
+  std::size_t t = tail.load(std::memory_order_relaxed);
+  std::size_t available = head.load(std::memory_order_acquire) - t;
+  std::size_t n = std::min(available, out.size());
+  
+  for(std::size_t i = 0; i < n; i++)
+    out[i] = events[(t + i) & (capacity - 1)];
+  
+  tail.store(t + n, std::memory_order_release);
+  
+  return n;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Input_Ring::get_dropped(){
+  return dropped.load(std::memory_order_relaxed);
+}
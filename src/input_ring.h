@@ -0,0 +1,81 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <span>
+#include <chrono>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+
+
+// used by API
+enum input_type{
+  in_key,   // code = GLFW key, action = GLFW_PRESS / GLFW_RELEASE / GLFW_REPEAT
+  in_mouse_button,   // code = GLFW mouse button, action = GLFW_PRESS / GLFW_RELEASE, value = cursor
+  in_cursor,   // value = cursor position (pixels, origin top left)
+  in_scroll   // value = scroll offset
+};
+
+
+
+// one GLFW event of one window (used by API)
+struct Input_Event{
+  std::uint64_t win_id = 0;
+  input_type type = in_key;
+  int code = 0;
+  int action = 0;
+  int mods = 0;   // GLFW modifier bits
+  glm::vec2 value = {0.0f, 0.0f};
+  std::chrono::steady_clock::time_point time;   // when GLFW delivered the event
+};
+
+
+
+//------------------------------------------------------------------------------
+// fixed size single-producer/single-consumer ring; the graphics thread pushes,
+// one API thread pops, neither side locks
+class Input_Ring{
+public:
+  static constexpr std::size_t capacity = 4096;   // power of 2
+  
+  Input_Ring();
+  ~Input_Ring();
+  bool push(const Input_Event& event);   // producer; false (event dropped) if full
+  std::size_t pop(std::span< Input_Event > out);   // consumer; returns number of events written
+  std::size_t get_dropped();
+  
+private:
+  std::array< Input_Event, capacity > events;
+  alignas(64) std::atomic< std::size_t > head = 0;   // next write (producer)
+  alignas(64) std::atomic< std::size_t > tail = 0;   // next read (consumer)
+  std::atomic< std::size_t > dropped = 0;
+};
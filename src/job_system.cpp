@@ -0,0 +1,199 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "job_system.h"
+
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Job_System::Job_System(std::size_t thread_count){
+  if(thread_count == 0)
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  
+  for(std::size_t i = 0; i < thread_count; i++)
+    queues.push_back( std::make_unique< Job_Queue >() );
+  
+  for(std::size_t i = 1; i < thread_count; i++)   // calling thread works too (queue 0)
+    workers.emplace_back(&Job_System::worker_loop, this, i);
+}
+
+
+
+//------------------------------------------------------------------------------
+Job_System::~Job_System(){
+  {
+    std::lock_guard lock(sleep_mutex);
+    stop = true;
+  }
+  wake.notify_all();
+  
+  for(auto &worker : workers)
+    worker.join();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Job_System::parallel_for(
+  std::size_t begin,
+  std::size_t end,
+  std::size_t grain,
+  const std::function< void(std::size_t, std::size_t) >& func
+){
+  if(begin >= end)
+    return;
+  
+  std::size_t n = end - begin;
+  grain = std::max<std::size_t>(grain, 1);
+  if(workers.empty()  ||  n <= grain){
+    func(begin, end);
+    return;
+  }
+  
+  // a few chunks per thread, so stealing can even out uneven chunks
+  std::size_t chunk = std::max( grain, (n + queues.size() * 4 - 1) / (queues.size() * 4) );
+  std::size_t chunk_count = (n + chunk - 1) / chunk;
+  
+  Join join;
+  join.func = &func;
+  join.remaining.store(chunk_count);
+  
+  for(std::size_t c = 0; c < chunk_count; c++){
+    Job job = { &join, begin + c * chunk, std::min(end, begin + (c + 1) * chunk) };
+    auto& queue = *queues[ next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size() ];
+    std::lock_guard lock(queue.mutex);
+    queue.jobs.push_back(job);
+  }
+  {
+    std::lock_guard lock(sleep_mutex);   // no lost wake-up between a worker's check & wait
+    queued.fetch_add(chunk_count);
+  }
+  wake.notify_all();
+  
+  // join: help until every chunk of this call is done
+  std::size_t self = own_queue() < queues.size()  ?  own_queue()  :  0;
+  while(join.remaining.load(std::memory_order_acquire) > 0)
+    if( !run_one(self) )
+      std::this_thread::yield();   // last chunks are running elsewhere
+  
+  if(join.error)
+    std::rethrow_exception(join.error);
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Job_System::get_thread_count(){
+  return queues.size();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Job_System::worker_loop(std::size_t self){
+  own_queue() = self;
+  
+  while(true){
+    {
+      std::unique_lock lock(sleep_mutex);
+      wake.wait(lock, [&](){  return stop  ||  queued.load() > 0;  });
+      if(stop)
+        return;
+    }
+    
+    while( run_one(self) ){}
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Job_System::run_one(std::size_t self){
+  Job job;
+  bool found = false;
+  
+  // own queue: front (oldest, likely still in cache)
+  {
+    auto& queue = *queues[self];
+    std::lock_guard lock(queue.mutex);
+    if( !queue.jobs.empty() ){
+      job = queue.jobs.front();
+      queue.jobs.pop_front();
+      found = true;
+    }
+  }
+  
+  // steal: back of the others
+  for(std::size_t i = 1; !found  &&  i < queues.size(); i++){
+    auto& queue = *queues[ (self + i) % queues.size() ];
+    std::lock_guard lock(queue.mutex);
+    if( !queue.jobs.empty() ){
+      job = queue.jobs.back();
+      queue.jobs.pop_back();
+      found = true;
+    }
+  }
+  
+  if( !found)
+    return false;
+  
+  queued.fetch_sub(1);
+  run(job);
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Job_System::run(const Job& job){
+  try{
+    (*job.join->func)(job.begin, job.end);
+  }
+  catch(...){
+    std::lock_guard lock(job.join->mutex);
+    if( !job.join->error)
+      job.join->error = std::current_exception();
+  }
+  
+  job.join->remaining.fetch_sub(1, std::memory_order_release);   // last access to join
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t& Job_System::own_queue(){
+  thread_local std::size_t index = 0;
+  return index;
+}
@@ -0,0 +1,88 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+
+
+//------------------------------------------------------------------------------
+// work-stealing scheduler for per-frame CPU work: every thread has its own
+// job deque, takes jobs from its front & steals from the back of the others;
+// a thread waiting for a parallel_for() runs jobs too (-> nesting works)
+class Job_System{
+public:
+  Job_System(std::size_t thread_count = 0);   // 0 = one per core (the calling thread is one of them)
+  ~Job_System();
+  void parallel_for(   // blocks until all chunks are done; rethrows the first exception of a chunk
+    std::size_t begin,
+    std::size_t end,
+    std::size_t grain,   // minimum chunk size (smaller ranges run on the calling thread)
+    const std::function< void(std::size_t, std::size_t) >& func   // [chunk begin, chunk end)
+  );
+  std::size_t get_thread_count();   // including the calling thread
+  
+private:
+  struct Join{   // one per parallel_for()
+    const std::function< void(std::size_t, std::size_t) >* func;
+    std::atomic< std::size_t > remaining;
+    std::mutex mutex;
+    std::exception_ptr error;
+  };
+  
+  struct Job{
+    Join* join;
+    std::size_t begin, end;
+  };
+  
+  struct Job_Queue{
+    std::mutex mutex;
+    std::deque< Job > jobs;
+  };
+  
+  std::vector< std::unique_ptr< Job_Queue > > queues;   // [0]: threads outside the pool
+  std::vector< std::thread > workers;
+  std::atomic< std::size_t > queued = 0;
+  std::atomic< std::size_t > next_queue = 0;   // round robin for new jobs
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  bool stop = false;   // guarded by sleep_mutex
+  
+  void worker_loop(std::size_t self);
+  bool run_one(std::size_t self);   // false if no job was found anywhere
+  static void run(const Job& job);
+  static std::size_t& own_queue();   // thread_local queue index
+};
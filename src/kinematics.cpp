@@ -0,0 +1,220 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "kinematics.h"
+
+#if defined(__SSE__)
+  #include <xmmintrin.h>
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Kinematics::Kinematics(){}
+
+
+
+//------------------------------------------------------------------------------
+Kinematics::~Kinematics(){}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::set_velocity(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, glm::vec2 velocity){
+  std::size_t i = get_index(gobj_id, obj);
+  vel_x[i] = velocity.x;
+  vel_y[i] = velocity.y;
+  remove_if_resting(i);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::set_acceleration(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, glm::vec2 acceleration){
+  std::size_t i = get_index(gobj_id, obj);
+  acc_x[i] = acceleration.x;
+  acc_y[i] = acceleration.y;
+  remove_if_resting(i);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::set_angular_velocity(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, float angular_velocity){
+  std::size_t i = get_index(gobj_id, obj);
+  ang_vel[i] = angular_velocity;
+  remove_if_resting(i);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::remove(std::uint64_t gobj_id){
+  auto i = index_of.find(gobj_id);
+  if(i != index_of.end())
+    remove_at(i->second);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::clear(){
+  index_of.clear();
+  ids.clear();
+  objects.clear();
+  pos_x.clear();   pos_y.clear();
+  vel_x.clear();   vel_y.clear();
+  acc_x.clear();   acc_y.clear();
+  rot.clear();     ang_vel.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::integrate(float delta_time, Job_System& jobs){
+  // chunks touch disjoint array ranges & objects
+  jobs.parallel_for(0, objects.size(), parallel_grain, [&](std::size_t begin, std::size_t end){
+    integrate_range(delta_time, begin, end);
+  });
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector< std::uint64_t >& Kinematics::get_ids(){
+  return ids;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t Kinematics::get_index(std::uint64_t gobj_id, std::shared_ptr<GObject> obj){
+  auto i = index_of.find(gobj_id);
+  if(i != index_of.end())
+    return i->second;
+  
+  index_of.insert( {gobj_id, ids.size()} );
+  ids.push_back(gobj_id);
+  objects.push_back(obj);
+  pos_x.push_back(0.0f);   pos_y.push_back(0.0f);
+  vel_x.push_back(0.0f);   vel_y.push_back(0.0f);
+  acc_x.push_back(0.0f);   acc_y.push_back(0.0f);
+  rot.push_back(0.0f);     ang_vel.push_back(0.0f);
+  
+  return ids.size() - 1;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::remove_if_resting(std::size_t i){
+  if(vel_x[i] == 0.0f && vel_y[i] == 0.0f && acc_x[i] == 0.0f && acc_y[i] == 0.0f && ang_vel[i] == 0.0f)
+    remove_at(i);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::remove_at(std::size_t i){
+  std::size_t last = ids.size() - 1;
+  
+  index_of.erase(ids[i]);
+  if(i != last){
+    index_of[ ids[last] ] = i;
+    
+    ids[i] = ids[last];
+    objects[i] = objects[last];
+    pos_x[i] = pos_x[last];   pos_y[i] = pos_y[last];
+    vel_x[i] = vel_x[last];   vel_y[i] = vel_y[last];
+    acc_x[i] = acc_x[last];   acc_y[i] = acc_y[last];
+    rot[i] = rot[last];       ang_vel[i] = ang_vel[last];
+  }
+  
+  ids.pop_back();
+  objects.pop_back();
+  pos_x.pop_back();   pos_y.pop_back();
+  vel_x.pop_back();   vel_y.pop_back();
+  acc_x.pop_back();   acc_y.pop_back();
+  rot.pop_back();     ang_vel.pop_back();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::integrate_range(float delta_time, std::size_t begin, std::size_t end){
+  // gather: positions may have been set since last frame (corrections, tweens)
+  for(std::size_t i = begin; i < end; i++){
+    glm::vec3 p = objects[i]->get_position();
+    pos_x[i] = p.x;
+    pos_y[i] = p.y;
+    rot[i] = objects[i]->get_rotation();
+  }
+  
+  integrate_arrays(delta_time, begin, end);
+  
+  // scatter
+  for(std::size_t i = begin; i < end; i++){
+    float z = objects[i]->get_position().z;
+    objects[i]->set_position( glm::vec3(pos_x[i], pos_y[i], z) );
+    objects[i]->set_rotation(rot[i]);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Kinematics::integrate_arrays(float delta_time, std::size_t begin, std::size_t end){
+  // semi-implicit Euler: v += a * dt; p += v * dt
+  std::size_t n = end;
+  std::size_t i = begin;
+  
+#if defined(__SSE__)
+  __m128 dt = _mm_set1_ps(delta_time);
+  for( ; i + 4 <= n; i += 4){
+    __m128 vx = _mm_add_ps( _mm_loadu_ps(&vel_x[i]), _mm_mul_ps(_mm_loadu_ps(&acc_x[i]), dt) );
+    __m128 vy = _mm_add_ps( _mm_loadu_ps(&vel_y[i]), _mm_mul_ps(_mm_loadu_ps(&acc_y[i]), dt) );
+    _mm_storeu_ps(&vel_x[i], vx);
+    _mm_storeu_ps(&vel_y[i], vy);
+    _mm_storeu_ps( &pos_x[i], _mm_add_ps(_mm_loadu_ps(&pos_x[i]), _mm_mul_ps(vx, dt)) );
+    _mm_storeu_ps( &pos_y[i], _mm_add_ps(_mm_loadu_ps(&pos_y[i]), _mm_mul_ps(vy, dt)) );
+    _mm_storeu_ps( &rot[i], _mm_add_ps(_mm_loadu_ps(&rot[i]), _mm_mul_ps(_mm_loadu_ps(&ang_vel[i]), dt)) );
+  }
+#endif
+  
+  for( ; i < n; i++){   // rest (or everything without SSE)
+    vel_x[i] += acc_x[i] * delta_time;
+    vel_y[i] += acc_y[i] * delta_time;
+    pos_x[i] += vel_x[i] * delta_time;
+    pos_y[i] += vel_y[i] * delta_time;
+    rot[i] += ang_vel[i] * delta_time;
+  }
+}
@@ -0,0 +1,74 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "graphics_object.h"
+#include "job_system.h"
+
+
+
+//------------------------------------------------------------------------------
+// velocity, acceleration & angular velocity of moving graphics_objects of one
+// window; stored as separate float arrays & integrated 4 objects at a time
+class Kinematics{
+public:
+  Kinematics();
+  ~Kinematics();
+  void set_velocity(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, glm::vec2 velocity);   // units / s
+  void set_acceleration(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, glm::vec2 acceleration);   // units / s^2
+  void set_angular_velocity(std::uint64_t gobj_id, std::shared_ptr<GObject> obj, float angular_velocity);   // degrees / s
+  void remove(std::uint64_t gobj_id);
+  void clear();
+  void integrate(float delta_time, Job_System& jobs);   // seconds; moves all objects (in parallel chunks)
+  const std::vector< std::uint64_t >& get_ids();   // moved objects
+  
+private:
+  static constexpr std::size_t parallel_grain = 4096;   // objects per chunk (at least)
+  
+  std::unordered_map< std::uint64_t, std::size_t > index_of;
+  std::vector< std::uint64_t > ids;
+  std::vector< std::shared_ptr<GObject> > objects;
+  
+  // one element per object
+  std::vector<float> pos_x, pos_y;
+  std::vector<float> vel_x, vel_y;
+  std::vector<float> acc_x, acc_y;
+  std::vector<float> rot, ang_vel;
+  
+  std::size_t get_index(std::uint64_t gobj_id, std::shared_ptr<GObject> obj);   // adds object if needed
+  void remove_if_resting(std::size_t i);
+  void remove_at(std::size_t i);   // swaps with last
+  void integrate_range(float delta_time, std::size_t begin, std::size_t end);
+  void integrate_arrays(float delta_time, std::size_t begin, std::size_t end);
+};
@@ -0,0 +1,206 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "message_coalescer.h"
+
+#include <functional>
+#include <unordered_set>
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+
+Message_Coalescer::Message_Coalescer(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+Message_Coalescer::~Message_Coalescer(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Message_Coalescer::add(Thread_Message& msg){
+  Key key;
+  if( !get_key(msg, key) )
+    return false;
+  
+  auto it = latest.find(key);
+  if(it != latest.end()){
+    messages[it->second] = std::move(msg);   // last writer wins
+    merged++;
+  }
+  else{
+    latest.insert( {key, messages.size()} );
+    messages.push_back( std::move(msg) );
+  }
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::vector< Thread_Message >& Message_Coalescer::pending(){
+  return messages;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Message_Coalescer::clear(){
+  latest.clear();
+  messages.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Message_Coalescer::get_merged_count(){
+  return merged;
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Message_Coalescer::is_coalescable(const Thread_Message& msg){
+  Key key;
+  return get_key(msg, key);
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Message_Coalescer::remove_superseded(std::deque< Thread_Message >& msgs){
+  // walk backwards: an update is superseded if a later one with the same key
+  // follows before the next barrier
+  std::unordered_set< Key, Key_Hash > seen;
+  std::vector< bool > keep(msgs.size(), true);
+  std::size_t removed = 0;
+  
+  for(std::size_t i = msgs.size(); i-- > 0;){
+    Key key;
+    if( !get_key(msgs[i], key) ){
+      seen.clear();
+      continue;
+    }
+    
+    if( !seen.insert(key).second ){
+      keep[i] = false;
+      removed++;
+    }
+  }
+  
+  if(removed == 0)
+    return 0;
+  
+  std::deque< Thread_Message > kept;
+  for(std::size_t i = 0; i < msgs.size(); i++)
+    if(keep[i])
+      kept.push_back( std::move(msgs[i]) );
+  
+  msgs.swap(kept);
+  return removed;
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Message_Coalescer::remove_oldest(std::deque< Thread_Message >& msgs){
+  auto it = std::find_if(msgs.begin(), msgs.end(), is_coalescable);
+  if(it == msgs.end())
+    return false;
+  
+  msgs.erase(it);
+  return true;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+
+bool Message_Coalescer::Key::operator==(const Key& other) const{
+  return win_id == other.win_id  &&  gobj_id == other.gobj_id  &&  type == other.type;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Message_Coalescer::Key_Hash::operator()(const Key& key) const{
+  std::size_t h = std::hash< id >{}(key.win_id);
+  h ^= std::hash< id >{}(key.gobj_id) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= std::hash< int >{}(key.type) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Message_Coalescer::get_key(const Thread_Message& msg, Key& key){
+  key.type = msg.type;
+  key.gobj_id = 0;
+  
+  switch(msg.type){
+    case Thread_Message::set_gobj_position:{
+      auto& param = std::get< std::tuple<id, id, glm::vec3> >(msg.parameters);
+      key.win_id = std::get<0>(param);
+      key.gobj_id = std::get<1>(param);
+      return true;
+    }
+    case Thread_Message::set_gobj_rotation:{
+      auto& param = std::get< std::tuple<id, id, float> >(msg.parameters);
+      key.win_id = std::get<0>(param);
+      key.gobj_id = std::get<1>(param);
+      return true;
+    }
+    case Thread_Message::set_camera_position:{
+      key.win_id = std::get<0>( std::get< std::tuple<id, glm::vec3> >(msg.parameters) );
+      return true;
+    }
+    case Thread_Message::set_camera_zoom:{
+      key.win_id = std::get<0>( std::get< std::tuple<id, float> >(msg.parameters) );
+      return true;
+    }
+    case Thread_Message::set_background_colour:{
+      key.win_id = std::get<0>( std::get< std::tuple<id, glm::vec3> >(msg.parameters) );
+      return true;
+    }
+    case Thread_Message::set_window_name:{
+      key.win_id = std::get<0>( std::get< std::tuple<id, std::string> >(msg.parameters) );
+      return true;
+    }
+    default:
+      return false;   // not idempotent or creates/destroys state: barrier
+  }
+}
@@ -0,0 +1,72 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstddef>
+
+#include "utils.h"
+
+
+
+//------------------------------------------------------------------------------
+// collects the messages of one drain of the API queue; idempotent state updates
+// (same window, object & message type) replace their predecessor, everything
+// else acts as a barrier: the owner processes pending() first, then the barrier
+class Message_Coalescer{
+public:
+  Message_Coalescer();
+  ~Message_Coalescer();
+  bool add(Thread_Message& msg);   // false if not coalescable (msg left untouched)
+  std::vector< Thread_Message >& pending();   // in order of first occurrence
+  void clear();
+  std::size_t get_merged_count();   // replaced messages since construction
+  static bool is_coalescable(const Thread_Message& msg);
+  static std::size_t remove_superseded(std::deque< Thread_Message >& msgs);   // lossless; returns removed count
+  static bool remove_oldest(std::deque< Thread_Message >& msgs);   // lossy; false if nothing coalescable
+  
+private:
+  struct Key{
+    id win_id;
+    id gobj_id;   // 0 for window-wide properties
+    Thread_Message::msg_type type;
+    bool operator==(const Key& other) const;
+  };
+  
+  struct Key_Hash{
+    std::size_t operator()(const Key& key) const;
+  };
+  
+  std::unordered_map< Key, std::size_t, Key_Hash > latest;   // index into messages
+  std::vector< Thread_Message > messages;
+  std::size_t merged = 0;
+  
+  static bool get_key(const Thread_Message& msg, Key& key);
+};
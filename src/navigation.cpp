@@ -0,0 +1,122 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "navigation.h"
+
+#include <cmath>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+
+Navigation::Navigation(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+Navigation::~Navigation(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::zoom(Camera& camera, glm::vec2 cursor, float scroll, glm::vec2 screen_size){
+  float old_zoom = camera.get_zoom();
+  camera.mod_zoom(- scroll * zoom_step);
+  float new_zoom = camera.get_zoom();
+  
+  // keep the world point under the cursor in place
+  glm::vec2 shift = (cursor - screen_size / 2.0f) * (new_zoom - old_zoom);
+  camera.set_position( camera.get_position() + glm::vec3(shift, 0.0f) );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::begin_drag(glm::vec2 cursor, std::chrono::steady_clock::time_point time){
+  dragging = true;
+  last_cursor = cursor;
+  last_move = time;
+  velocity = {0.0f, 0.0f};
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::drag(Camera& camera, glm::vec2 cursor, std::chrono::steady_clock::time_point time){
+  if( !dragging )
+    return;
+  
+  // one pixel of cursor movement = zoom world units
+  glm::vec2 delta = (cursor - last_cursor) * camera.get_zoom();
+  camera.set_position( camera.get_position() + glm::vec3(delta, 0.0f) );
+  
+  float dt = std::chrono::duration<float>(time - last_move).count();
+  if(dt > 0.0f)
+    velocity = 0.5f * velocity + 0.5f * (delta / dt);   // smooth out jittery events
+  
+  last_cursor = cursor;
+  last_move = time;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::end_drag(std::chrono::steady_clock::time_point time){
+  if( !dragging )
+    return;
+  
+  dragging = false;
+  if( !inertia  ||  std::chrono::duration<float>(time - last_move).count() > max_release_delay )
+    velocity = {0.0f, 0.0f};
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::update(Camera& camera, float delta_time){
+  if(dragging  ||  velocity == glm::vec2(0.0f, 0.0f))
+    return;
+  
+  camera.set_position( camera.get_position() + glm::vec3(velocity * delta_time, 0.0f) );
+  
+  velocity *= std::exp(- friction * delta_time);
+  if(glm::length(velocity) < min_speed)
+    velocity = {0.0f, 0.0f};
+}
+
+
+
+//------------------------------------------------------------------------------
+void Navigation::stop(){
+  dragging = false;
+  velocity = {0.0f, 0.0f};
+}
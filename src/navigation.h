@@ -0,0 +1,65 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <chrono>
+
+#include <glm/glm.hpp>
+
+#include "camera.h"
+
+
+
+//------------------------------------------------------------------------------
+// mouse driven camera control of one window (drag to pan, scroll to zoom
+// around the cursor, optional inertia after a drag); cursor positions are in
+// framebuffer pixels, origin top left
+class Navigation{
+public:
+  Navigation();
+  ~Navigation();
+  void zoom(Camera& camera, glm::vec2 cursor, float scroll, glm::vec2 screen_size);
+  void begin_drag(glm::vec2 cursor, std::chrono::steady_clock::time_point time);
+  void drag(Camera& camera, glm::vec2 cursor, std::chrono::steady_clock::time_point time);   // ignored if not dragging
+  void end_drag(std::chrono::steady_clock::time_point time);
+  void update(Camera& camera, float delta_time);   // seconds; applies inertia
+  void stop();   // ends drag & inertia
+  
+  bool inertia = false;
+  
+private:
+  static constexpr float zoom_step = 0.1f;   // per scroll unit
+  static constexpr float friction = 5.0f;   // velocity decay per second (exponential)
+  static constexpr float min_speed = 1.0f;   // world units / s
+  static constexpr float max_release_delay = 0.05f;   // seconds; holding still longer cancels inertia
+  
+  bool dragging = false;
+  glm::vec2 last_cursor = {0.0f, 0.0f};
+  std::chrono::steady_clock::time_point last_move;
+  glm::vec2 velocity = {0.0f, 0.0f};   // world units / s
+};
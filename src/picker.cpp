@@ -0,0 +1,309 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "picker.h"
+
+#include <algorithm>
+#include <exception>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Picker::Picker(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+Picker::~Picker(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::add(std::shared_ptr< Pick_Request > request){
+  requests.push_back(request);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Picker::waiting(){
+  return ! requests.empty();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::begin_pass(int width, int height){
+  if( ! buffers_ready  ||  width != texture_width  ||  height != texture_height)
+    setup_texture(width, height);
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glDisable(GL_BLEND);   // ids must not be mixed
+  
+  const GLuint nothing[4] = {0, 0, 0, 0};
+  glClearBufferuiv(GL_COLOR, 0, nothing);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::end_pass(){
+  Readback readback;
+  std::size_t texels = 0;
+  
+  // clamp to framebuffer; GL rows start at the bottom
+  for(auto &request : requests){
+    int x0 = std::clamp(request->x, 0, texture_width);
+    int y0 = std::clamp(request->y, 0, texture_height);
+    int x1 = std::clamp(request->x + request->width, 0, texture_width);
+    int y1 = std::clamp(request->y + request->height, 0, texture_height);
+    request->x = x0;
+    request->y = y0;
+    request->width = x1 - x0;
+    request->height = y1 - y0;
+    
+    readback.requests.push_back(request);
+    readback.offsets.push_back(texels);
+    texels += request->width * request->height;
+  }
+  requests.clear();
+  
+  glGenBuffers(1, &readback.pixel_buffer);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixel_buffer);
+  glBufferData(GL_PIXEL_PACK_BUFFER, std::max<std::size_t>(texels, 1) * 2 * sizeof(GLuint), nullptr, GL_STREAM_READ);
+  
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  for(std::size_t i = 0; i < readback.requests.size(); i++){
+    auto &request = *readback.requests[i];
+    if(request.width == 0  ||  request.height == 0)
+      continue;
+    
+    glReadPixels(
+      request.x,
+      texture_height - request.y - request.height,
+      request.width,
+      request.height,
+      GL_RG_INTEGER,
+      GL_UNSIGNED_INT,
+      (void*)(readback.offsets[i] * 2 * sizeof(GLuint))   // offset into pixel buffer
+    );
+  }
+  
+  readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  readbacks.push_back(readback);
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glEnable(GL_BLEND);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::collect(){
+  while( ! readbacks.empty() ){
+    auto &readback = readbacks.front();
+    
+    GLenum state = glClientWaitSync(readback.fence, 0, 0);   // don't wait
+    if(state != GL_ALREADY_SIGNALED  &&  state != GL_CONDITION_SATISFIED)
+      return;   // later readbacks can't be done either
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixel_buffer);
+    GLint size;
+    glGetBufferParameteriv(GL_PIXEL_PACK_BUFFER, GL_BUFFER_SIZE, &size);
+    auto texels = (const GLuint*) glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    
+    if(texels){
+      for(std::size_t i = 0; i < readback.requests.size(); i++)
+        fulfil(*readback.requests[i], texels + readback.offsets[i] * 2);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    glDeleteSync(readback.fence);
+    glDeleteBuffers(1, &readback.pixel_buffer);
+    readbacks.pop_front();
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::clear(){
+  for(auto &readback : readbacks){
+    glDeleteSync(readback.fence);
+    glDeleteBuffers(1, &readback.pixel_buffer);
+  }
+  readbacks.clear();
+  requests.clear();
+  
+  delete_buffers();
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec4 Picker::encode(id gobj_id){
+  id value = gobj_id + 1;   // 0 = nothing
+  
+  // 16 bit per component -> exact as float
+  return glm::vec4(
+    (float)( value        & 0xFFFF),
+    (float)((value >> 16) & 0xFFFF),
+    (float)((value >> 32) & 0xFFFF),
+    (float)((value >> 48) & 0xFFFF)
+  );
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::string Picker::shape_vert_shader = 
+  "#version 450 core\n"
+  "\n"
+  "layout (location = 0) in vec3 in_pos;\n"
+  "layout (location = 2) in mat4 in_model;   // per draw (locations 2 - 5)\n"
+  "layout (location = 6) in vec4 in_id;   // per draw (encoded id)\n"
+  "\n"
+  "flat out vec4 id;\n"
+  "\n"
+  "uniform mat4 view;\n"
+  "uniform mat4 projection;\n"
+  "\n"
+  "void main(){\n"
+  "  gl_Position = projection * view * in_model * vec4(in_pos, 1.0f);\n"
+  "  id = in_id;\n"
+  "}";
+
+
+
+//------------------------------------------------------------------------------
+const std::string Picker::shape_frag_shader = 
+  "#version 450 core\n"
+  "\n"
+  "flat in vec4 id;\n"
+  "layout (location = 0) out uvec2 frag_id;\n"
+  "\n"
+  "void main(){\n"
+  "  uvec4 v = uvec4(round(id));\n"
+  "  frag_id = uvec2(v.x | (v.y << 16), v.z | (v.w << 16));\n"
+  "}";
+
+
+
+//------------------------------------------------------------------------------
+const std::string Picker::sprite_frag_shader = 
+  "#version 450 core\n"
+  "\n"
+  "in vec3 tex_coord;\n"
+  "in vec4 tint;   // encoded id\n"
+  "layout (location = 0) out uvec2 frag_id;\n"
+  "\n"
+  "uniform sampler2DArray atlas;   // texture unit 0\n"
+  "\n"
+  "void main(){\n"
+  "  if(texture(atlas, tex_coord).a < 0.5f)   // transparent pixels can't be picked\n"
+  "    discard;\n"
+  "  uvec4 v = uvec4(round(tint));\n"
+  "  frag_id = uvec2(v.x | (v.y << 16), v.z | (v.w << 16));\n"
+  "}";
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Picker::setup_texture(int width, int height){
+  delete_buffers();
+  
+  texture_width = std::max(width, 1);
+  texture_height = std::max(height, 1);
+  
+  glGenTextures(1, &id_texture);
+  glBindTexture(GL_TEXTURE_2D, id_texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RG32UI, texture_width, texture_height);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, id_texture, 0);
+  
+  if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    throw std::runtime_error("Picker: Id framebuffer is incomplete!");
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::fulfil(Pick_Request& request, const GLuint* texels){
+  std::vector< id > ids;
+  std::size_t count = request.width * request.height;
+  
+  for(std::size_t i = 0; i < count; i++){
+    id value = texels[2 * i] | ((id)texels[2 * i + 1] << 32);
+    if(value != 0)
+      ids.push_back(value - 1);
+  }
+  
+  std::sort(ids.begin(), ids.end());
+  ids.erase( std::unique(ids.begin(), ids.end()), ids.end() );
+  
+  if(auto single = std::get_if< std::promise< std::optional< id > > >(&request.result)){
+    if(ids.empty())
+      single->set_value(std::nullopt);
+    else
+      single->set_value(ids.front());   // one texel -> at most one id
+  }
+  else
+    std::get< std::promise< std::vector< id > > >(request.result).set_value(ids);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Picker::delete_buffers(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteFramebuffers(1, &framebuffer);
+  glDeleteTextures(1, &id_texture);
+  buffers_ready = false;
+}
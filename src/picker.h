@@ -0,0 +1,99 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <future>
+#include <optional>
+#include <variant>
+#include <string>
+#include <cstdint>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "utils.h"
+
+
+
+// one pick of the API; rectangle in framebuffer pixels, origin top left
+struct Pick_Request{
+  int x, y, width, height;
+  std::variant<
+    std::promise< std::optional< id > >,   // single texel: topmost object
+    std::promise< std::vector< id > >   // rectangle: all visible objects
+  > result;
+};
+
+
+
+//------------------------------------------------------------------------------
+// renders object ids into an integer texture (RG32UI: low & high 32 bit of
+// id + 1, 0 = nothing) and reads the requested texels back through a pixel
+// buffer a frame later, so the graphics thread never waits for the GPU
+class Picker{
+public:
+  Picker();
+  ~Picker();   // pending requests -> futures throw std::future_error (broken promise)
+  void add(std::shared_ptr< Pick_Request > request);   // graphics thread
+  bool waiting();   // graphics thread (requests that need an id pass this frame)
+  void begin_pass(int width, int height);   // graphics thread (binds id framebuffer)
+  void end_pass();   // graphics thread (starts readback, binds default framebuffer)
+  void collect();   // graphics thread (fulfils requests whose readback finished)
+  void clear();   // graphics thread (drops pending requests)
+  static glm::vec4 encode(id gobj_id);   // as instance colour / tint of the pick programs
+  
+  static const std::string shape_vert_shader;
+  static const std::string shape_frag_shader;
+  static const std::string sprite_frag_shader;
+  
+private:
+  struct Readback{
+    std::vector< std::shared_ptr< Pick_Request > > requests;
+    std::vector< std::size_t > offsets;   // first texel of each request in buffer
+    GLuint pixel_buffer;
+    GLsync fence;
+  };
+  
+  GLuint framebuffer, id_texture;
+  int texture_width = 0, texture_height = 0;
+  bool buffers_ready = false;
+  
+  std::vector< std::shared_ptr< Pick_Request > > requests;   // not rendered yet
+  std::deque< Readback > readbacks;   // in flight, oldest first
+  
+  void setup_texture(int width, int height);
+  void fulfil(Pick_Request& request, const GLuint* texels);
+  void delete_buffers();
+};
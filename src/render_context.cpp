@@ -0,0 +1,199 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "render_context.h"
+
+#include <exception>
+
+#include "graphics_point_set.h"
+#include "shape_batch.h"
+#include "sprite_batch.h"
+#include "picker.h"
+#include "snapshot_layer.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Render_Context::Render_Context(){
+  camera_ready.fill(false);
+  programs[p_shape] = new_program(p_shape);   // always needed
+  
+  // sprites have transparent pixels; shapes are opaque, so this doesn't change them
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+
+
+//------------------------------------------------------------------------------
+Render_Context::~Render_Context(){}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::begin_frame(Camera& camera, float width, float height){
+  this->camera = &camera;
+  this->width = width;
+  this->height = height;
+  region = {0.0f, 0.0f, 1.0f, 1.0f};
+  pixel_scale = 1.0f;
+  
+  camera_ready.fill(false);
+  current_program = -1;
+  current_vertex_array = 0;
+  current_texture = 0;
+  stats = {};
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::set_region(glm::vec4 region, float pixel_scale){
+  this->region = region;
+  this->pixel_scale = pixel_scale;
+  camera_ready.fill(false);
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr<Shader_Program> Render_Context::use_program(program_type type){
+  if( ! programs[type])
+    programs[type] = new_program(type);
+  
+  if(current_program != type){
+    programs[type]->use();
+    current_program = type;
+    stats.state_changes++;
+  }
+  
+  if( ! camera_ready[type]){   // view & projection only change once per frame
+    camera->update(programs[type], width, height, region);
+    camera_ready[type] = true;
+  }
+  
+  return programs[type];
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::bind_vertex_array(GLuint vertex_array_object){
+  if(current_vertex_array == vertex_array_object)
+    return;
+  
+  glBindVertexArray(vertex_array_object);
+  current_vertex_array = vertex_array_object;
+  stats.state_changes++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::bind_texture_array(GLuint texture){
+  if(current_texture == texture)
+    return;
+  
+  glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+  current_texture = texture;
+  stats.state_changes++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::draw_elements(GLenum mode, std::size_t count){
+  glDrawElements(mode, count, GL_UNSIGNED_INT, 0);
+  stats.draw_calls++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::draw_arrays(GLenum mode, std::size_t first, std::size_t count){
+  glDrawArrays(mode, first, count);
+  stats.draw_calls++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::draw_arrays_instanced(GLenum mode, std::size_t count, std::size_t instance_count){
+  glDrawArraysInstanced(mode, 0, count, instance_count);
+  stats.draw_calls++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::multi_draw_elements_indirect(GLenum mode, std::size_t draw_count){
+  glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, 0, draw_count, 0);
+  stats.draw_calls++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Context::count_objects(std::size_t n){
+  stats.objects += n;
+}
+
+
+
+//------------------------------------------------------------------------------
+float Render_Context::get_pixels_per_unit(){
+  return pixel_scale / camera->get_zoom();
+}
+
+
+
+//------------------------------------------------------------------------------
+Render_Stats Render_Context::get_stats(){
+  return stats;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<Shader_Program> Render_Context::new_program(program_type type){
+  switch(type){
+  case p_shape:     return std::make_shared<Shader_Program>();   // default shaders
+  case p_shape_batch: return std::make_shared<Shader_Program>(Shape_Batch::vert_shader, Shape_Batch::frag_shader);
+  case p_sprite:    return std::make_shared<Shader_Program>(Sprite_Batch::vert_shader, Sprite_Batch::frag_shader);
+  case p_point_set: return std::make_shared<Shader_Program>(GPoint_Set::vert_shader, GPoint_Set::frag_shader);
+  case p_shape_pick:  return std::make_shared<Shader_Program>(Picker::shape_vert_shader, Picker::shape_frag_shader);
+  case p_sprite_pick: return std::make_shared<Shader_Program>(Sprite_Batch::vert_shader, Picker::sprite_frag_shader);
+  case p_snapshot:  return std::make_shared<Shader_Program>(Snapshot_Layer::vert_shader, Shape_Batch::frag_shader);
+  default:          throw std::runtime_error("Render_Context: Invalid program type!");
+  }
+}
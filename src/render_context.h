@@ -0,0 +1,102 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <array>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "shader_program.h"
+#include "camera.h"
+
+
+
+enum program_type{
+  p_shape,
+  p_shape_batch,
+  p_sprite,
+  p_point_set,
+  p_shape_pick,
+  p_sprite_pick,
+  p_snapshot,
+  program_type_count
+};
+
+
+
+// numbers of one frame of one window (used by API)
+struct Render_Stats{
+  std::size_t objects = 0;   // rendered through the render queue
+  std::size_t draw_calls = 0;
+  std::size_t state_changes = 0;   // shader program, vertex array & texture switches
+  std::size_t atlas_pages = 0;
+  float atlas_occupancy = 0.0f;   // 0 - 1
+  float render_time = 0.0f;   // seconds the graphics thread spent rendering the frame
+};
+
+
+
+//------------------------------------------------------------------------------
+// per-window GL state used by all graphics_objects of that window
+class Render_Context{
+public:
+  Render_Context();   // graphics thread (context of owning window has to be current)
+  ~Render_Context();
+  void begin_frame(Camera& camera, float width, float height);   // graphics thread
+  void set_region(glm::vec4 region, float pixel_scale);   // graphics thread (render only part of the view, e.g. a tile; after begin_frame)
+  std::shared_ptr<Shader_Program> use_program(program_type type);   // graphics thread
+  void bind_vertex_array(GLuint vertex_array_object);   // graphics thread (skips redundant binds)
+  void bind_texture_array(GLuint texture);   // graphics thread (skips redundant binds)
+  void draw_elements(GLenum mode, std::size_t count);   // graphics thread
+  void draw_arrays(GLenum mode, std::size_t first, std::size_t count);   // graphics thread
+  void draw_arrays_instanced(GLenum mode, std::size_t count, std::size_t instance_count);   // graphics thread
+  void multi_draw_elements_indirect(GLenum mode, std::size_t draw_count);   // graphics thread (commands from bound GL_DRAW_INDIRECT_BUFFER)
+  void count_objects(std::size_t n);
+  float get_pixels_per_unit();
+  Render_Stats get_stats();
+  
+private:
+  std::array< std::shared_ptr<Shader_Program>, program_type_count > programs;   // created on first use
+  std::array< bool, program_type_count > camera_ready;   // camera uniforms set this frame
+  int current_program = -1;
+  GLuint current_vertex_array = 0;
+  GLuint current_texture = 0;
+  Render_Stats stats;
+  Camera* camera = nullptr;
+  float width = 0.0f;
+  float height = 0.0f;
+  glm::vec4 region = {0.0f, 0.0f, 1.0f, 1.0f};
+  float pixel_scale = 1.0f;   // target pixels per screen pixel
+  
+  std::shared_ptr<Shader_Program> new_program(program_type type);
+};
@@ -0,0 +1,108 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "render_queue.h"
+
+#include <algorithm>
+#include <array>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Render_Queue::Render_Queue(){}
+
+
+
+//------------------------------------------------------------------------------
+Render_Queue::~Render_Queue(){}
+
+
+
+//------------------------------------------------------------------------------
+void Render_Queue::invalidate(){
+  dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector<Render_Queue::Item>& Render_Queue::sort(const std::unordered_map< id, std::shared_ptr<GObject> >& objects, Job_System& jobs){
+  if(dirty){
+    by_id.clear();
+    for(const auto &obj : objects)
+      by_id.push_back( {0, obj.first, obj.second.get()} );
+    
+    std::sort(by_id.begin(), by_id.end(), [](const Item& a, const Item& b){  return a.gobj_id < b.gobj_id;  });
+    dirty = false;
+  }
+  
+  // keys change whenever objects move -> recompute every frame
+  items = by_id;
+  jobs.parallel_for(0, items.size(), parallel_grain, [&](std::size_t begin, std::size_t end){
+    for(std::size_t i = begin; i < end; i++)
+      items[i].key = items[i].obj->get_sort_key();
+  });
+  
+  radix_sort();   // stable -> equal keys stay in id order
+  return items;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Render_Queue::radix_sort(){
+  buffer.resize(items.size());
+  
+  // LSD radix sort, one byte per pass
+  for(uint shift = 0; shift < 64; shift += 8){
+    std::array< std::size_t, 256 > count = {};
+    for(const auto &i : items)
+      count[(i.key >> shift) & 0xFF]++;
+    
+    // all keys share this byte (e.g. only one layer in use) -> nothing to do
+    if(std::find(count.begin(), count.end(), items.size()) != count.end())
+      continue;
+    
+    std::size_t offset = 0;
+    for(auto &c : count){
+      std::size_t n = c;
+      c = offset;
+      offset += n;
+    }
+    
+    for(const auto &i : items)
+      buffer[ count[(i.key >> shift) & 0xFF]++ ] = i;
+    
+    items.swap(buffer);
+  }
+}
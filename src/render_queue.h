@@ -0,0 +1,66 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include "graphics_object.h"
+#include "utils.h"
+#include "job_system.h"
+
+
+
+//------------------------------------------------------------------------------
+// draw order of a window's graphics_objects, sorted by GObject::get_sort_key()
+// (ties are broken by id -> order does not depend on hash map layout)
+class Render_Queue{
+public:
+  struct Item{
+    std::uint64_t key;
+    id gobj_id;
+    GObject* obj;
+  };
+  
+  Render_Queue();
+  ~Render_Queue();
+  void invalidate();   // graphics thread (call whenever objects are added/removed)
+  const std::vector<Item>& sort(const std::unordered_map< id, std::shared_ptr<GObject> >& objects, Job_System& jobs);   // graphics thread
+  
+private:
+  static constexpr std::size_t parallel_grain = 8192;   // keys per chunk (at least)
+  
+  std::vector<Item> by_id;   // rebuilt only after invalidate()
+  std::vector<Item> items;
+  std::vector<Item> buffer;   // radix sort scratch space
+  bool dirty = true;
+  
+  void radix_sort();
+};
@@ -0,0 +1,187 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "scene_snapshot.h"
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <bit>
+#include <exception>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Scene_Snapshot::Scene_Snapshot(const std::string& path){
+  if constexpr(std::endian::native != std::endian::little)
+    throw std::runtime_error("Scene_Snapshot: Snapshots are only supported on little-endian machines!");
+  
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd == -1)
+    throw std::runtime_error("Scene_Snapshot: Could not open " + path + "!");
+  
+  struct stat info;
+  if(fstat(fd, &info) == -1  ||  info.st_size < (off_t)sizeof(Snapshot_Header)){
+    ::close(fd);
+    throw std::runtime_error("Scene_Snapshot: " + path + " is not a snapshot!");
+  }
+  
+  data_size = info.st_size;
+  void* mapping = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);   // mapping stays valid
+  if(mapping == MAP_FAILED)
+    throw std::runtime_error("Scene_Snapshot: Could not map " + path + "!");
+  
+  data = (const std::uint8_t*)mapping;
+  madvise(mapping, data_size, MADV_SEQUENTIAL | MADV_WILLNEED);   // read once, front to back
+  
+  try{  validate();  }
+  catch(std::exception& e){
+    munmap((void*)data, data_size);
+    throw std::runtime_error("Scene_Snapshot: " + path + ": " + e.what());
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+Scene_Snapshot::~Scene_Snapshot(){
+  munmap((void*)data, data_size);
+}
+
+
+
+//------------------------------------------------------------------------------
+const Snapshot_Header& Scene_Snapshot::get_header(){
+  return *(const Snapshot_Header*)data;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const Snapshot_Object > Scene_Snapshot::get_objects(){
+  const auto& header = get_header();
+  std::size_t count = header.object_counts[0] + header.object_counts[1] + header.object_counts[2];
+  return { (const Snapshot_Object*)(data + header.object_offset), count };
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const Snapshot_Object > Scene_Snapshot::get_objects(gobj_type type){
+  const auto& header = get_header();
+  std::size_t first = 0;
+  for(int t = 0; t < type; t++)
+    first += header.object_counts[t];
+  
+  return get_objects().subspan(first, header.object_counts[type]);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Scene_Snapshot::write(
+  const std::string& path,
+  glm::vec3 camera_position,
+  float camera_zoom,
+  glm::vec3 background_colour,
+  const std::array< std::vector< Snapshot_Object >, 3 >& objects
+){
+  if constexpr(std::endian::native != std::endian::little)
+    throw std::runtime_error("Scene_Snapshot: Snapshots are only supported on little-endian machines!");
+  
+  Snapshot_Header header = {};
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.header_size = sizeof(Snapshot_Header);
+  header.camera_position = camera_position;
+  header.camera_zoom = camera_zoom;
+  header.background_colour = background_colour;
+  header.object_offset = ( (sizeof(Snapshot_Header) + sizeof(Snapshot_Object) - 1) / sizeof(Snapshot_Object) ) * sizeof(Snapshot_Object);
+  for(std::size_t t = 0; t < objects.size(); t++)
+    header.object_counts[t] = objects[t].size();
+  
+  // write next to the target, then rename -> an existing mapping of 'path' stays intact
+  std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if( ! file)
+      throw std::runtime_error("Scene_Snapshot: Could not open " + tmp_path + "!");
+    
+    file.write( (const char*)&header, sizeof(header) );
+    std::array< char, sizeof(Snapshot_Object) > padding = {};
+    file.write( padding.data(), header.object_offset - sizeof(header) );
+    for(const auto &type_objects : objects)
+      file.write( (const char*)type_objects.data(), type_objects.size() * sizeof(Snapshot_Object) );
+    
+    file.flush();
+    if( ! file){
+      std::remove(tmp_path.c_str());
+      throw std::runtime_error("Scene_Snapshot: Writing " + tmp_path + " failed!");
+    }
+  }
+  
+  if(std::rename(tmp_path.c_str(), path.c_str()) != 0){
+    std::remove(tmp_path.c_str());
+    throw std::runtime_error("Scene_Snapshot: Could not replace " + path + "!");
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Scene_Snapshot::validate(){
+  const auto& header = get_header();
+  
+  if(std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+    throw std::runtime_error("Not a snapshot!");
+  if(header.version != version)
+    throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version) + "!");
+  if(header.header_size != sizeof(Snapshot_Header))
+    throw std::runtime_error("Invalid header size!");
+  if(header.object_offset < sizeof(Snapshot_Header)  ||  header.object_offset % sizeof(Snapshot_Object) != 0)
+    throw std::runtime_error("Invalid object offset!");
+  
+  // overflow-safe: each count is checked against the remaining space
+  std::size_t space = (data_size - std::min<std::size_t>(header.object_offset, data_size)) / sizeof(Snapshot_Object);
+  for(auto count : header.object_counts){
+    if(count > space)
+      throw std::runtime_error("File is truncated!");
+    space -= count;
+  }
+}
@@ -0,0 +1,108 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <string>
+#include <array>
+#include <span>
+#include <future>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "utils.h"
+
+
+
+// file layout (version 1, little-endian, offsets from start of file):
+//   Snapshot_Header
+//   Snapshot_Object[ sum of object_counts ]   (all triangles, then rectangles, then circles)
+// no pointers -> the file can be used in place wherever it is mapped
+
+struct Snapshot_Header{
+  char magic[8];   // "S2DSNAP" + '\0'
+  std::uint32_t version;
+  std::uint32_t header_size;   // sizeof(Snapshot_Header)
+  glm::vec3 camera_position;
+  float camera_zoom;
+  glm::vec3 background_colour;
+  std::uint32_t reserved;   // 0
+  std::uint64_t object_offset;   // multiple of sizeof(Snapshot_Object)
+  std::array< std::uint64_t, 3 > object_counts;   // per gobj_type
+};
+
+struct Snapshot_Object{   // one GShape (world transform)
+  glm::vec3 position;
+  float rotation;   // degrees
+  float size;
+  glm::vec3 colour;
+};
+
+static_assert(sizeof(Snapshot_Header) == 80, "Snapshot_Header must not contain padding!");
+static_assert(sizeof(Snapshot_Object) == 32, "Snapshot_Object must not contain padding!");
+
+
+
+// one save of the API
+struct Snapshot_Request{
+  std::string path;
+  std::promise< void > done;
+};
+
+
+
+//------------------------------------------------------------------------------
+// read-only memory mapping of a snapshot file; validated once, then used as is
+class Scene_Snapshot{
+public:
+  Scene_Snapshot(const std::string& path);   // throws std::runtime_error
+  ~Scene_Snapshot();
+  Scene_Snapshot(const Scene_Snapshot&) = delete;
+  Scene_Snapshot& operator=(const Scene_Snapshot&) = delete;
+  
+  const Snapshot_Header& get_header();
+  std::span< const Snapshot_Object > get_objects();   // all types
+  std::span< const Snapshot_Object > get_objects(gobj_type type);
+  
+  static void write(   // throws std::runtime_error (replaces file atomically)
+    const std::string& path,
+    glm::vec3 camera_position,
+    float camera_zoom,
+    glm::vec3 background_colour,
+    const std::array< std::vector< Snapshot_Object >, 3 >& objects   // per gobj_type
+  );
+  
+  static constexpr std::uint32_t version = 1;
+  static constexpr char magic[8] = "S2DSNAP";
+  
+private:
+  const std::uint8_t* data = nullptr;
+  std::size_t data_size = 0;
+  
+  void validate();
+};
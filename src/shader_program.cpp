@@ -60,6 +60,18 @@ Shader_Program::Shader_Program(const std::vector< std::string >& file_names){
 
 
 
+//------------------------------------------------------------------------------
+Shader_Program::Shader_Program(const std::string& vert_source, const std::string& frag_source){
+  shader_program = glCreateProgram();
+  
+  compile_shader(GL_VERTEX_SHADER, vert_source);
+  compile_shader(GL_FRAGMENT_SHADER, frag_source);
+    
+  compile_shader_program();
+}
+
+
+
 //------------------------------------------------------------------------------
 Shader_Program::~Shader_Program(){}
 
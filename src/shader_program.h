@@ -43,6 +43,7 @@ class Shader_Program{
 public:
   Shader_Program();
   Shader_Program(const std::vector< std::string >& file_names);
+  Shader_Program(const std::string& vert_source, const std::string& frag_source);
   ~Shader_Program();
   void use();
   void set_uni(const std::string& name ,float x);
@@ -0,0 +1,303 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "shape_batch.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Shape_Batch::Shape_Batch(){}
+
+
+
+//------------------------------------------------------------------------------
+Shape_Batch::~Shape_Batch(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::add(GShape& shape){
+  add( shape, glm::vec4(shape.get_colour(), 0.0f) );   // vertex colours are added in shader
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::add(GShape& shape, glm::vec4 colour){
+  const Region& region = get_region(shape.get_mesh());
+  
+  Draw_Command command;
+  command.count = region.count;
+  command.instance_count = 1;
+  command.first_index = region.first_index;
+  command.base_vertex = region.base_vertex;
+  command.base_instance = instances.size();
+  commands.push_back(command);
+  
+  instances.push_back( {shape.get_model_matrix(), colour} );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::add(const std::vector< GShape* >& shapes, Job_System& jobs){
+  // regions first (may rebuild the arena); meshes repeat in runs after sorting
+  GMesh* previous = nullptr;
+  for(auto shape : shapes){
+    GMesh* mesh = shape->get_mesh().get();
+    if(mesh != previous){
+      get_region( shape->get_mesh() );
+      previous = mesh;
+    }
+  }
+  
+  // each chunk writes its own range of commands & instances; the region map is only read
+  std::size_t base = commands.size();
+  commands.resize(base + shapes.size());
+  instances.resize(base + shapes.size());
+  
+  jobs.parallel_for(0, shapes.size(), parallel_grain, [&](std::size_t begin, std::size_t end){
+    for(std::size_t i = begin; i < end; i++){
+      GShape& shape = *shapes[i];
+      const Region& region = regions.find( shape.get_mesh().get() )->second;
+      
+      Draw_Command& command = commands[base + i];
+      command.count = region.count;
+      command.instance_count = 1;
+      command.first_index = region.first_index;
+      command.base_vertex = region.base_vertex;
+      command.base_instance = base + i;
+      
+      instances[base + i] = { shape.get_model_matrix(), glm::vec4(shape.get_colour(), 0.0f) };   // vertex colours are added in shader
+    }
+  });
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::flush(Render_Context& context, program_type program){
+  if(commands.empty())
+    return;
+  
+  context.use_program(program);   // same vertex layout for the pick program
+  
+  if( ! buffers_ready)
+    setup_buffers(context);
+  
+  context.bind_vertex_array(vertex_array_object);
+  if(arena_dirty)
+    upload_arena();
+  
+  // per-draw data (orphaned every flush, so the driver doesn't have to wait for the previous draw)
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Instance), instances.data(), GL_STREAM_DRAW);
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);
+  glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(Draw_Command), commands.data(), GL_STREAM_DRAW);
+  
+  context.multi_draw_elements_indirect(GL_TRIANGLES, commands.size());
+  
+  commands.clear();
+  instances.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::clear(){
+  commands.clear();
+  instances.clear();
+  regions.clear();
+  arena_vertices.clear();
+  arena_indices.clear();
+  arena_dirty = false;
+  delete_buffers();
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Shape_Batch::empty(){
+  return commands.empty();
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::string Shape_Batch::vert_shader = 
+  "#version 450 core\n"
+  "\n"
+  "layout (location = 0) in vec3 in_pos;\n"
+  "layout (location = 1) in vec3 in_color;\n"
+  "layout (location = 2) in mat4 in_model;   // per draw (locations 2 - 5)\n"
+  "layout (location = 6) in vec4 in_uni_color;   // per draw\n"
+  "\n"
+  "out vec4 vertex_color;\n"
+  "\n"
+  "uniform mat4 view;\n"
+  "uniform mat4 projection;\n"
+  "\n"
+  "void main(){\n"
+  "  gl_Position = projection * view * in_model * vec4(in_pos, 1.0f);\n"
+  "  vertex_color = in_uni_color + vec4(in_color, 1.0f);\n"
+  "}";
+
+
+
+//------------------------------------------------------------------------------
+const std::string Shape_Batch::frag_shader = 
+  "#version 450 core\n"
+  "\n"
+  "in vec4 vertex_color;\n"
+  "out vec4 frag_color;\n"
+  "\n"
+  "void main(){\n"
+  "  frag_color = vertex_color;\n"
+  "}";
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+Shape_Batch::Region& Shape_Batch::get_region(std::shared_ptr<GMesh> mesh){
+  auto r = regions.find(mesh.get());
+  if(r != regions.end())
+    return r->second;
+  
+  // new mesh -> drop meshes only the arena still uses before growing it
+  // (not while commands of this batch point into the arena)
+  bool garbage = false;
+  for(auto &region : regions)
+    if(region.second.mesh.use_count() == 1)
+      garbage = true;
+  if(garbage && commands.empty())
+    rebuild_arena();
+  
+  append_region(mesh);
+  return regions.at(mesh.get());
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::append_region(std::shared_ptr<GMesh> mesh){
+  const auto& vertices = mesh->get_vertices();
+  const auto& indices = mesh->get_indices();
+  
+  Region region;
+  region.mesh = mesh;
+  region.base_vertex = arena_vertices.size();
+  region.first_index = arena_indices.size() * 3;
+  region.count = indices.size() * 3;
+  
+  arena_vertices.insert(arena_vertices.end(), vertices.begin(), vertices.end());
+  arena_indices.insert(arena_indices.end(), indices.begin(), indices.end());
+  regions.insert( {mesh.get(), region} );
+  arena_dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::rebuild_arena(){
+  std::vector< std::shared_ptr<GMesh> > alive;
+  for(auto &region : regions)
+    if(region.second.mesh.use_count() > 1)
+      alive.push_back(region.second.mesh);
+  
+  regions.clear();
+  arena_vertices.clear();
+  arena_indices.clear();
+  
+  for(auto &mesh : alive)
+    append_region(mesh);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::setup_buffers(Render_Context& context){
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);
+  
+  glGenBuffers(1, &vertex_buffer);
+  glGenBuffers(1, &element_buffer);
+  glGenBuffers(1, &instance_buffer);
+  glGenBuffers(1, &indirect_buffer);
+  
+  // arena (same layout as GMesh)
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
+  glEnableVertexAttribArray(1);
+  
+  // per draw: advanced once per instance, so 'base_instance' of a command selects its entry
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  for(uint column = 0; column < 4; column++){
+    glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(column * sizeof(glm::vec4)));
+    glEnableVertexAttribArray(2 + column);
+    glVertexAttribDivisor(2 + column, 1);
+  }
+  glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)sizeof(glm::mat4));
+  glEnableVertexAttribArray(6);
+  glVertexAttribDivisor(6, 1);
+  
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::upload_arena(){   // vertex array object has to be bound
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, arena_vertices.size() * sizeof(Vertex), arena_vertices.data(), GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, arena_indices.size() * sizeof(Index3), arena_indices.data(), GL_STATIC_DRAW);   // element buffer is part of the vertex array object
+  arena_dirty = false;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shape_Batch::delete_buffers(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &vertex_buffer);
+  glDeleteBuffers(1, &element_buffer);
+  glDeleteBuffers(1, &instance_buffer);
+  glDeleteBuffers(1, &indirect_buffer);
+  buffers_ready = false;
+}
@@ -0,0 +1,104 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "graphics_object.h"
+#include "job_system.h"
+
+
+
+//------------------------------------------------------------------------------
+// draws any mix of GShapes with a single glMultiDrawElementsIndirect:
+// all meshes of a window live in one vertex/index arena, every shape is one
+// indirect command whose baseInstance selects its model matrix & colour
+class Shape_Batch{
+public:
+  Shape_Batch();
+  ~Shape_Batch();
+  void add(GShape& shape);   // graphics thread
+  void add(GShape& shape, glm::vec4 colour);   // graphics thread (overrides colour of shape)
+  void add(const std::vector< GShape* >& shapes, Job_System& jobs);   // graphics thread (per-draw data filled in parallel chunks)
+  void flush(Render_Context& context, program_type program = p_shape_batch);   // graphics thread (draws & empties the batch)
+  void clear();   // graphics thread
+  bool empty();
+  
+  static const std::string vert_shader;
+  static const std::string frag_shader;
+  
+private:
+  // layout given by OpenGL
+  struct Draw_Command{
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+  };
+  
+  struct Instance{
+    glm::mat4 model;
+    glm::vec4 colour;
+  };
+  
+  struct Region{
+    std::shared_ptr<GMesh> mesh;   // keeps mesh alive while it is part of the arena
+    GLint base_vertex;
+    GLuint first_index;
+    GLuint count;
+  };
+  
+  GLuint vertex_buffer, element_buffer, instance_buffer, indirect_buffer, vertex_array_object;
+  bool buffers_ready = false;
+  
+  std::unordered_map< GMesh*, Region > regions;
+  std::vector<Vertex> arena_vertices;
+  std::vector<Index3> arena_indices;
+  bool arena_dirty = false;
+  
+  std::vector<Draw_Command> commands;   // this batch
+  std::vector<Instance> instances;   // this batch
+  
+  static constexpr std::size_t parallel_grain = 2048;   // shapes per chunk (at least)
+  
+  Region& get_region(std::shared_ptr<GMesh> mesh);
+  void append_region(std::shared_ptr<GMesh> mesh);
+  void rebuild_arena();
+  void setup_buffers(Render_Context& context);
+  void upload_arena();
+  void delete_buffers();
+};
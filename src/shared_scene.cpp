@@ -0,0 +1,129 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "shared_scene.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+
+Shared_Scene::Shared_Scene(std::vector< std::uint64_t > gobj_ids)
+  : ids( std::move(gobj_ids) ){
+  
+  for(auto& buffer : buffers){
+    buffer.positions.resize(ids.size(), glm::vec3(0.0f));
+    buffer.rotations.resize(ids.size(), 0.0f);
+    buffer.colours.resize(ids.size(), glm::vec3(1.0f));
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+Shared_Scene::~Shared_Scene(){
+  
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Shared_Scene::size(){
+  return ids.size();
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector< std::uint64_t >& Shared_Scene::get_ids(){
+  return ids;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< glm::vec3 > Shared_Scene::positions(){
+  return buffers[back].positions;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< float > Shared_Scene::rotations(){
+  return buffers[back].rotations;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< glm::vec3 > Shared_Scene::colours(){
+  return buffers[back].colours;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Shared_Scene::publish(){
+  std::uint8_t published = back;
+  back = latest.exchange(published | fresh, std::memory_order_acq_rel) & index_mask;
+  
+  // the graphics thread only ever reads the published buffer -> safe to copy;
+  // keeps "write only what changed" semantics for the producer
+  buffers[back] = buffers[published];
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Shared_Scene::acquire(){
+  if( !(latest.load(std::memory_order_relaxed) & fresh) )
+    return false;
+  
+  front = latest.exchange(front, std::memory_order_acq_rel) & index_mask;
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const glm::vec3 > Shared_Scene::front_positions(){
+  return buffers[front].positions;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const float > Shared_Scene::front_rotations(){
+  return buffers[front].rotations;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const glm::vec3 > Shared_Scene::front_colours(){
+  return buffers[front].colours;
+}
@@ -0,0 +1,78 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <array>
+#include <atomic>
+#include <span>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+
+
+//------------------------------------------------------------------------------
+// positions, rotations & colours of a fixed set of graphics_objects, triple
+// buffered: one producer thread writes the back buffer and publishes it with
+// an atomic index swap, the graphics thread picks up the latest published
+// buffer; neither side locks or waits for the other
+class Shared_Scene{
+public:
+  Shared_Scene(std::vector< std::uint64_t > gobj_ids);
+  ~Shared_Scene();
+  std::size_t size();
+  const std::vector< std::uint64_t >& get_ids();   // slot -> graphics_object
+  
+  // producer thread
+  std::span< glm::vec3 > positions();   // back buffer
+  std::span< float > rotations();   // back buffer (degrees)
+  std::span< glm::vec3 > colours();   // back buffer
+  void publish();   // new back buffer starts as a copy of the published one
+  
+  // graphics thread
+  bool acquire();   // false if nothing was published since last call
+  std::span< const glm::vec3 > front_positions();
+  std::span< const float > front_rotations();
+  std::span< const glm::vec3 > front_colours();
+  
+private:
+  struct Buffer{
+    std::vector< glm::vec3 > positions;
+    std::vector< float > rotations;
+    std::vector< glm::vec3 > colours;
+  };
+  
+  static constexpr std::uint8_t index_mask = 0x3;
+  static constexpr std::uint8_t fresh = 0x4;   // set while the latest buffer is unread
+  
+  std::vector< std::uint64_t > ids;
+  std::array< Buffer, 3 > buffers;
+  std::atomic< std::uint8_t > latest = 1;   // index (| fresh); shared
+  std::uint8_t back = 0;   // producer thread
+  std::uint8_t front = 2;   // graphics thread
+};
@@ -0,0 +1,215 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "snapshot_layer.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Snapshot_Layer::Snapshot_Layer(){}
+
+
+
+//------------------------------------------------------------------------------
+Snapshot_Layer::~Snapshot_Layer(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Snapshot_Layer::set(std::shared_ptr< Scene_Snapshot > snapshot){
+  this->snapshot = snapshot;
+  uploaded = false;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Snapshot_Layer::clear(){
+  snapshot.reset();
+  uploaded = false;
+  delete_buffers();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Snapshot_Layer::render(Render_Context& context){
+  if( ! snapshot)
+    return;
+  
+  context.use_program(p_snapshot);
+  
+  if( ! buffers_ready)
+    setup_buffers(context);
+  
+  context.bind_vertex_array(vertex_array_object);
+  if( ! uploaded)
+    upload();
+  
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);   // not part of the vertex array object
+  context.multi_draw_elements_indirect(GL_TRIANGLES, commands.size());
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Snapshot_Layer::size(){
+  return snapshot ? snapshot->get_objects().size() : 0;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::span< const Snapshot_Object > Snapshot_Layer::get_objects(gobj_type type){
+  if( ! snapshot)
+    return {};
+  
+  return snapshot->get_objects(type);
+}
+
+
+
+//------------------------------------------------------------------------------
+// same transformation as GShape::get_model_matrix(), done per vertex
+const std::string Snapshot_Layer::vert_shader = 
+  "#version 450 core\n"
+  "\n"
+  "layout (location = 0) in vec3 in_pos;\n"
+  "layout (location = 1) in vec3 in_color;\n"
+  "layout (location = 2) in vec3 in_offset;   // per instance (Snapshot_Object)\n"
+  "layout (location = 3) in float in_rotation;   // per instance\n"
+  "layout (location = 4) in float in_size;   // per instance\n"
+  "layout (location = 5) in vec3 in_uni_color;   // per instance\n"
+  "\n"
+  "out vec4 vertex_color;\n"
+  "\n"
+  "uniform mat4 view;\n"
+  "uniform mat4 projection;\n"
+  "\n"
+  "void main(){\n"
+  "  float r = radians(in_rotation);\n"
+  "  vec2 p = in_pos.xy * in_size;\n"
+  "  p = vec2(p.x * cos(r) - p.y * sin(r), p.x * sin(r) + p.y * cos(r));\n"
+  "  gl_Position = projection * view * vec4(p + in_offset.xy, in_pos.z + in_offset.z, 1.0f);\n"
+  "  vertex_color = vec4(in_uni_color, 0.0f) + vec4(in_color, 1.0f);\n"
+  "}";
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Snapshot_Layer::setup_buffers(Render_Context& context){
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);
+  
+  glGenBuffers(1, &vertex_buffer);
+  glGenBuffers(1, &element_buffer);
+  glGenBuffers(1, &instance_buffer);
+  glGenBuffers(1, &indirect_buffer);
+  
+  // unit meshes of all gobj_types (same layout as GMesh)
+  std::vector<Vertex> vertices;
+  std::vector<Index3> indices;
+  std::array< std::shared_ptr<GMesh>, 3 > meshes = {
+    GTriangle::new_unit_mesh(),
+    GRect::new_unit_mesh(),
+    GCircle::new_unit_mesh()
+  };
+  for(std::size_t t = 0; t < meshes.size(); t++){
+    commands[t].count = meshes[t]->get_indices().size() * 3;
+    commands[t].first_index = indices.size() * 3;
+    commands[t].base_vertex = vertices.size();
+    vertices.insert(vertices.end(), meshes[t]->get_vertices().begin(), meshes[t]->get_vertices().end());
+    indices.insert(indices.end(), meshes[t]->get_indices().begin(), meshes[t]->get_indices().end());
+  }
+  
+  glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);   // part of the vertex array object
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(Index3), indices.data(), GL_STATIC_DRAW);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
+  glEnableVertexAttribArray(1);
+  
+  // per instance: the file records themselves
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Snapshot_Object), (void*)offsetof(Snapshot_Object, position));
+  glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Snapshot_Object), (void*)offsetof(Snapshot_Object, rotation));
+  glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Snapshot_Object), (void*)offsetof(Snapshot_Object, size));
+  glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, sizeof(Snapshot_Object), (void*)offsetof(Snapshot_Object, colour));
+  for(GLuint location = 2; location <= 5; location++){
+    glEnableVertexAttribArray(location);
+    glVertexAttribDivisor(location, 1);
+  }
+  
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Snapshot_Layer::upload(){   // vertex array object has to be bound
+  auto objects = snapshot->get_objects();
+  
+  // straight from the mapping, no parsing
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  glBufferData(GL_ARRAY_BUFFER, objects.size_bytes(), objects.data(), GL_STATIC_DRAW);
+  
+  GLuint base_instance = 0;
+  for(std::size_t t = 0; t < commands.size(); t++){
+    commands[t].instance_count = snapshot->get_header().object_counts[t];
+    commands[t].base_instance = base_instance;
+    base_instance += commands[t].instance_count;
+  }
+  glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer);
+  glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(commands), commands.data(), GL_STATIC_DRAW);
+  
+  uploaded = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Snapshot_Layer::delete_buffers(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &vertex_buffer);
+  glDeleteBuffers(1, &element_buffer);
+  glDeleteBuffers(1, &instance_buffer);
+  glDeleteBuffers(1, &indirect_buffer);
+  buffers_ready = false;
+}
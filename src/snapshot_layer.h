@@ -0,0 +1,84 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <string>
+#include <span>
+#include <cstddef>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "graphics_object.h"
+#include "scene_snapshot.h"
+
+
+
+//------------------------------------------------------------------------------
+// GShapes restored from a snapshot: the mapped object records are uploaded
+// as they are (one buffer copy) and drawn as instances of the unit meshes
+// with a single multi-draw; the shapes can't be changed individually
+class Snapshot_Layer{
+public:
+  Snapshot_Layer();
+  ~Snapshot_Layer();
+  void set(std::shared_ptr< Scene_Snapshot > snapshot);   // graphics thread (uploaded on next render)
+  void clear();   // graphics thread
+  void render(Render_Context& context);   // graphics thread
+  std::size_t size();
+  std::span< const Snapshot_Object > get_objects(gobj_type type);   // graphics thread
+  
+  static const std::string vert_shader;
+  
+private:
+  // layout given by OpenGL
+  struct Draw_Command{
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+  };
+  
+  std::shared_ptr< Scene_Snapshot > snapshot;   // keeps mapping alive (needed for saving again)
+  GLuint vertex_buffer, element_buffer, instance_buffer, indirect_buffer, vertex_array_object;
+  bool buffers_ready = false;
+  bool uploaded = false;
+  std::array< Draw_Command, 3 > commands;   // per gobj_type
+  
+  void setup_buffers(Render_Context& context);
+  void upload();
+  void delete_buffers();
+};
@@ -0,0 +1,266 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "soft_rasterizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Soft_Rasterizer::Soft_Rasterizer(Job_System& jobs)
+  : jobs(jobs){}
+
+
+
+//------------------------------------------------------------------------------
+Soft_Rasterizer::~Soft_Rasterizer(){}
+
+
+
+//------------------------------------------------------------------------------
+void Soft_Rasterizer::begin_frame(int width, int height, glm::vec3 background){
+  this->width = std::max(width, 0);
+  this->height = std::max(height, 0);
+  tiles_x = (this->width + tile_size - 1) / tile_size;
+  tiles_y = (this->height + tile_size - 1) / tile_size;
+  stride = tiles_x * tile_size;
+  
+  colour_buffer.resize( (std::size_t)stride * tiles_y * tile_size );   // tiles never need bounds checks
+  clear_colour = pack(background);
+  
+  triangles.clear();
+  bins.resize(tiles_x * tiles_y);
+  for(auto &bin : bins)
+    bin.clear();   // keeps capacity
+}
+
+
+
+//------------------------------------------------------------------------------
+void Soft_Rasterizer::add(
+  const std::vector<Vertex>& vertices,
+  const std::vector<Index3>& indices,
+  const glm::mat4& transform,
+  glm::vec3 colour
+){
+  // same mapping as the GL viewport, but first row = top
+  auto to_screen = [&](const Vertex& v){
+    glm::vec4 ndc = transform * glm::vec4(v.position, 1.0f);
+    return glm::vec2( (ndc.x + 1.0f) * 0.5f * width, (1.0f - ndc.y) * 0.5f * height );
+  };
+  
+  for(const auto &index : indices){
+    Triangle tri;
+    const Vertex* v[3] = { &vertices[index.a], &vertices[index.b], &vertices[index.c] };
+    bool finite = true;
+    for(int i = 0; i < 3; i++){
+      tri.p[i] = to_screen(*v[i]);
+      tri.colour[i] = glm::clamp(v[i]->colour + colour, 0.0f, 1.0f);
+      finite = finite  &&  std::isfinite(tri.p[i].x)  &&  std::isfinite(tri.p[i].y);
+    }
+    if( !finite )
+      continue;
+    
+    // counter-clockwise on screen (edge functions >= 0 inside)
+    float area = (tri.p[1].x - tri.p[0].x) * (tri.p[2].y - tri.p[0].y) - (tri.p[1].y - tri.p[0].y) * (tri.p[2].x - tri.p[0].x);
+    if(area == 0.0f  ||  std::isnan(area))
+      continue;
+    if(area < 0.0f){
+      std::swap(tri.p[1], tri.p[2]);
+      std::swap(tri.colour[1], tri.colour[2]);
+    }
+    tri.flat = tri.colour[0] == tri.colour[1]  &&  tri.colour[1] == tri.colour[2];
+    
+    // bin by bounding box
+    float min_x = std::min({tri.p[0].x, tri.p[1].x, tri.p[2].x});
+    float max_x = std::max({tri.p[0].x, tri.p[1].x, tri.p[2].x});
+    float min_y = std::min({tri.p[0].y, tri.p[1].y, tri.p[2].y});
+    float max_y = std::max({tri.p[0].y, tri.p[1].y, tri.p[2].y});
+    if(max_x < 0.0f  ||  max_y < 0.0f  ||  min_x >= width  ||  min_y >= height)
+      continue;
+    
+    // clamp as floats first: far zoomed in, coordinates don't fit an int
+    int tx0 = (int)std::max(min_x, 0.0f) / tile_size;
+    int ty0 = (int)std::max(min_y, 0.0f) / tile_size;
+    int tx1 = (int)std::min(max_x, (float)(width - 1)) / tile_size;
+    int ty1 = (int)std::min(max_y, (float)(height - 1)) / tile_size;
+    
+    std::uint32_t t = triangles.size();
+    triangles.push_back(tri);
+    for(int ty = ty0; ty <= ty1; ty++)
+      for(int tx = tx0; tx <= tx1; tx++)
+        bins[ty * tiles_x + tx].push_back(t);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Soft_Rasterizer::end_frame(){
+  jobs.parallel_for(0, bins.size(), 1, [&](std::size_t begin, std::size_t end){
+    for(std::size_t tile = begin; tile < end; tile++)
+      rasterize_tile(tile);
+  });
+}
+
+
+
+//------------------------------------------------------------------------------
+void Soft_Rasterizer::read_pixels(std::vector< std::uint8_t >& rgba){
+  rgba.resize( (std::size_t)width * height * 4 );
+  for(int y = 0; y < height; y++)
+    std::memcpy( rgba.data() + (std::size_t)y * width * 4, colour_buffer.data() + (std::size_t)y * stride, (std::size_t)width * 4 );
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Soft_Rasterizer::get_triangle_count(){
+  return triangles.size();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Soft_Rasterizer::rasterize_tile(std::size_t tile){
+  int x0 = (tile % tiles_x) * tile_size;
+  int y0 = (tile / tiles_x) * tile_size;
+  
+  for(int y = y0; y < y0 + tile_size; y++)
+    std::fill_n( colour_buffer.data() + (std::size_t)y * stride + x0, tile_size, clear_colour );
+  
+  for(auto t : bins[tile])
+    rasterize( triangles[t], x0, y0, x0 + tile_size, y0 + tile_size );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Soft_Rasterizer::rasterize(const Triangle& tri, int x0, int y0, int x1, int y1){
+  const glm::vec2 &a = tri.p[0], &b = tri.p[1], &c = tri.p[2];
+  
+  // bounding box inside tile (clamped as floats before the cast); x aligned to the SIMD width (rows are whole tiles)
+  int bx0 = (int)std::floor( std::clamp(std::min({a.x, b.x, c.x}), (float)x0, (float)x1) ) & ~3;
+  int by0 = (int)std::floor( std::clamp(std::min({a.y, b.y, c.y}), (float)y0, (float)y1) );
+  int bx1 = (int)std::ceil( std::clamp(std::max({a.x, b.x, c.x}) + 1.0f, (float)x0, (float)x1) );
+  int by1 = (int)std::ceil( std::clamp(std::max({a.y, b.y, c.y}) + 1.0f, (float)y0, (float)y1) );
+  if(bx0 >= bx1  ||  by0 >= by1)
+    return;
+  
+  // edge functions w(x, y) = w_start + dx * x + dy * y, sampled at pixel centres
+  auto edge = [](glm::vec2 p, glm::vec2 q, float& dx, float& dy){
+    dx = -(q.y - p.y);
+    dy = q.x - p.x;
+    return -p.x * dx - p.y * dy;
+  };
+  float dx0, dy0, dx1, dy1, dx2, dy2;
+  float e0 = edge(b, c, dx0, dy0);   // weight of a
+  float e1 = edge(c, a, dx1, dy1);   // weight of b
+  float e2 = edge(a, b, dx2, dy2);   // weight of c
+  float inv_area = 1.0f / (e0 + dx0 * a.x + dy0 * a.y);
+  std::uint32_t flat_colour = pack(tri.colour[0]);
+  
+  auto shade = [&](float w0, float w1, float w2){
+    if(tri.flat)
+      return flat_colour;
+    return pack( (w0 * tri.colour[0] + w1 * tri.colour[1] + w2 * tri.colour[2]) * inv_area );
+  };
+  
+  for(int y = by0; y < by1; y++){
+    float py = y + 0.5f;
+    float row0 = e0 + dy0 * py;
+    float row1 = e1 + dy1 * py;
+    float row2 = e2 + dy2 * py;
+    std::uint32_t* row = colour_buffer.data() + (std::size_t)y * stride;
+    
+#if defined(__SSE2__)
+    const __m128 lane = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128i flat = _mm_set1_epi32(flat_colour);
+    
+    for(int x = bx0; x < bx1; x += 4){
+      __m128 px = _mm_add_ps( _mm_set1_ps((float)x), lane );
+      __m128 w0 = _mm_add_ps( _mm_set1_ps(row0), _mm_mul_ps(_mm_set1_ps(dx0), px) );
+      __m128 w1 = _mm_add_ps( _mm_set1_ps(row1), _mm_mul_ps(_mm_set1_ps(dx1), px) );
+      __m128 w2 = _mm_add_ps( _mm_set1_ps(row2), _mm_mul_ps(_mm_set1_ps(dx2), px) );
+      __m128 inside = _mm_and_ps( _mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero) );
+      int mask = _mm_movemask_ps(inside);
+      if(mask == 0)
+        continue;
+      
+      if(tri.flat){   // masked store of 4 pixels
+        __m128i m = _mm_castps_si128(inside);
+        __m128i dst = _mm_loadu_si128( (__m128i*)(row + x) );
+        dst = _mm_or_si128( _mm_and_si128(m, flat), _mm_andnot_si128(m, dst) );
+        _mm_storeu_si128( (__m128i*)(row + x), dst );
+      }
+      else{
+        alignas(16) float l0[4], l1[4], l2[4];
+        _mm_store_ps(l0, w0);
+        _mm_store_ps(l1, w1);
+        _mm_store_ps(l2, w2);
+        for(int i = 0; i < 4; i++)
+          if(mask & (1 << i))
+            row[x + i] = shade(l0[i], l1[i], l2[i]);
+      }
+    }
+#else
+    for(int x = bx0; x < bx1; x++){
+      float px = x + 0.5f;
+      float w0 = row0 + dx0 * px;
+      float w1 = row1 + dx1 * px;
+      float w2 = row2 + dx2 * px;
+      if(w0 >= 0.0f  &&  w1 >= 0.0f  &&  w2 >= 0.0f)
+        row[x] = shade(w0, w1, w2);
+    }
+#endif
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+std::uint32_t Soft_Rasterizer::pack(glm::vec3 colour){
+  colour = glm::clamp(colour, 0.0f, 1.0f);
+  return (std::uint32_t)(colour.x * 255.0f + 0.5f)
+    | (std::uint32_t)(colour.y * 255.0f + 0.5f) << 8
+    | (std::uint32_t)(colour.z * 255.0f + 0.5f) << 16
+    | 0xFF000000u;   // opaque (shapes are drawn with alpha 1)
+}
@@ -0,0 +1,82 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "graphics_object.h"
+#include "job_system.h"
+
+
+
+//------------------------------------------------------------------------------
+// CPU backend for windows without OpenGL: triangles are transformed & binned
+// into screen tiles on the calling thread, then the job system rasterizes the
+// tiles in parallel (SSE2 edge functions, 4 pixels per step); within a tile
+// triangles are drawn in submission order, like the GL path without depth test
+class Soft_Rasterizer{
+public:
+  Soft_Rasterizer(Job_System& jobs);
+  ~Soft_Rasterizer();
+  void begin_frame(int width, int height, glm::vec3 background);   // graphics thread
+  void add(   // graphics thread
+    const std::vector<Vertex>& vertices,
+    const std::vector<Index3>& indices,
+    const glm::mat4& transform,   // projection * view * model
+    glm::vec3 colour   // added to vertex colours (like the shape shaders)
+  );
+  void end_frame();   // graphics thread (rasterizes; blocks until done)
+  void read_pixels(std::vector< std::uint8_t >& rgba);   // graphics thread (r, g, b, a; first row = top)
+  std::size_t get_triangle_count();   // last frame
+  
+private:
+  struct Triangle{
+    glm::vec2 p[3];   // pixels, origin top left
+    glm::vec3 colour[3];
+    bool flat;   // all colours equal
+  };
+  
+  static constexpr int tile_size = 64;   // multiple of 4 (SIMD width)
+  
+  int width = 0, height = 0;
+  int stride = 0;   // pixels per row (whole tiles)
+  int tiles_x = 0, tiles_y = 0;
+  std::uint32_t clear_colour = 0;
+  std::vector< std::uint32_t > colour_buffer;   // RGBA8 (little-endian -> r first in memory)
+  std::vector< Triangle > triangles;
+  std::vector< std::vector< std::uint32_t > > bins;   // triangle indices per tile
+  
+  Job_System& jobs;
+  
+  void rasterize_tile(std::size_t tile);   // any thread (tiles are disjoint)
+  void rasterize(const Triangle& tri, int x0, int y0, int x1, int y1);   // clipped to [x0, x1) x [y0, y1)
+  static std::uint32_t pack(glm::vec3 colour);
+};
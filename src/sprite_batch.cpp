@@ -0,0 +1,227 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "sprite_batch.h"
+
+#include <cmath>
+
+#include "bitmap_font.h"
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Sprite_Batch::Sprite_Batch(){}
+
+
+
+//------------------------------------------------------------------------------
+Sprite_Batch::~Sprite_Batch(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::add(GSprite& sprite, Texture_Atlas& atlas){
+  add( sprite, atlas, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f) );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::add(GSprite& sprite, Texture_Atlas& atlas, glm::vec4 tint){
+  const Texture_Atlas::Entry* entry = atlas.get( sprite.get_image() );
+  if( ! entry)
+    return;
+  
+  float half_width = sprite.get_size() * 0.5f;
+  float aspect = (float)entry->height / entry->width;
+  
+  Instance instance;
+  instance.position = sprite.get_world_position();
+  instance.rotation = glm::radians( sprite.get_world_rotation() );
+  instance.half_size = glm::vec2(half_width, half_width * aspect);
+  instance.page = entry->page;
+  instance.uv_rect = entry->uv_rect;
+  instance.tint = tint;
+  instances.push_back(instance);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::add(GText& text, Texture_Atlas& atlas){
+  add( text, atlas, glm::vec4(text.get_colour(), 1.0f) );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::add(GText& text, Texture_Atlas& atlas, glm::vec4 tint){
+  const Texture_Atlas::Entry* font_entry = atlas.get(Bitmap_Font::image_id);
+  if( ! font_entry)
+    return;
+  
+  glm::vec3 position = text.get_world_position();
+  float rotation = glm::radians( text.get_world_rotation() );
+  float s = sin(rotation);
+  float c = cos(rotation);
+  
+  Instance instance;
+  instance.rotation = rotation;
+  instance.half_size = text.get_glyph_half_size();
+  instance.page = font_entry->page;
+  instance.tint = tint;
+  
+  for(const auto &glyph : text.get_glyphs(*font_entry)){
+    glm::vec2 o = glyph.offset;
+    instance.position = position + glm::vec3(c * o.x - s * o.y, s * o.x + c * o.y, 0.0f);
+    instance.uv_rect = glyph.uv_rect;
+    instances.push_back(instance);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::add(const Instance& instance){
+  instances.push_back(instance);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::flush(Render_Context& context, Texture_Atlas& atlas, program_type program){
+  if(instances.empty())
+    return;
+  
+  context.use_program(program);
+  
+  if( ! buffers_ready)
+    setup_buffers(context);
+  
+  context.bind_vertex_array(vertex_array_object);
+  atlas.bind(context);
+  
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(Instance), instances.data(), GL_STREAM_DRAW);
+  
+  context.draw_arrays_instanced(GL_TRIANGLE_STRIP, 4, instances.size());   // corners from gl_VertexID
+  
+  instances.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::clear(){
+  instances.clear();
+  delete_buffers();
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::string Sprite_Batch::vert_shader = 
+  "#version 450 core\n"
+  "\n"
+  "layout (location = 0) in vec4 in_transform;   // x, y, z, rotation (radians)\n"
+  "layout (location = 1) in vec4 in_size;   // half width, half height, atlas page\n"
+  "layout (location = 2) in vec4 in_uv;   // u0, v0, u1, v1\n"
+  "layout (location = 3) in vec4 in_tint;\n"
+  "\n"
+  "out vec3 tex_coord;\n"
+  "out vec4 tint;\n"
+  "\n"
+  "uniform mat4 view;\n"
+  "uniform mat4 projection;\n"
+  "\n"
+  "void main(){\n"
+  "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);   // (0, 0), (1, 0), (0, 1), (1, 1)\n"
+  "  vec2 p = (corner * 2.0f - 1.0f) * in_size.xy;\n"
+  "  float s = sin(in_transform.w);\n"
+  "  float c = cos(in_transform.w);\n"
+  "  p = vec2(c * p.x - s * p.y, s * p.x + c * p.y);\n"
+  "  gl_Position = projection * view * vec4(in_transform.xy + p, in_transform.z, 1.0f);\n"
+  "  tex_coord = vec3(mix(in_uv.xy, in_uv.zw, corner), in_size.z);   // corner.y = 0: top (y-down camera) = first image row\n"
+  "  tint = in_tint;\n"
+  "}";
+
+
+
+//------------------------------------------------------------------------------
+const std::string Sprite_Batch::frag_shader = 
+  "#version 450 core\n"
+  "\n"
+  "in vec3 tex_coord;\n"
+  "in vec4 tint;\n"
+  "out vec4 frag_color;\n"
+  "\n"
+  "uniform sampler2DArray atlas;   // texture unit 0\n"
+  "\n"
+  "void main(){\n"
+  "  frag_color = texture(atlas, tex_coord) * tint;\n"
+  "  if(frag_color.a == 0.0f)\n"
+  "    discard;\n"
+  "}";
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Sprite_Batch::setup_buffers(Render_Context& context){
+  glGenVertexArrays(1, &vertex_array_object);
+  context.bind_vertex_array(vertex_array_object);
+  
+  glGenBuffers(1, &instance_buffer);
+  glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+  
+  // everything is per instance (4 x vec4)
+  for(uint a = 0; a < 4; a++){
+    glVertexAttribPointer(a, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(a * sizeof(glm::vec4)));
+    glEnableVertexAttribArray(a);
+    glVertexAttribDivisor(a, 1);
+  }
+  
+  buffers_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Sprite_Batch::delete_buffers(){
+  if( ! buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &vertex_array_object);
+  glDeleteBuffers(1, &instance_buffer);
+  buffers_ready = false;
+}
@@ -0,0 +1,80 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+#include "texture_atlas.h"
+#include "graphics_sprite.h"
+#include "graphics_text.h"
+
+
+
+//------------------------------------------------------------------------------
+// textured quads from one Texture_Atlas in a single instanced draw
+// (the page is a layer of the array texture -> no rebinds between pages)
+class Sprite_Batch{
+public:
+  struct Instance{
+    glm::vec3 position;
+    float rotation;   // radians
+    glm::vec2 half_size;
+    float page;
+    float unused = 0.0f;
+    glm::vec4 uv_rect;   // u0, v0, u1, v1 (v0 = top)
+    glm::vec4 tint;   // multiplied with texture colour
+  };
+  
+  Sprite_Batch();
+  ~Sprite_Batch();
+  void add(GSprite& sprite, Texture_Atlas& atlas);   // graphics thread (skipped if image is unknown)
+  void add(GSprite& sprite, Texture_Atlas& atlas, glm::vec4 tint);   // graphics thread
+  void add(GText& text, Texture_Atlas& atlas);   // graphics thread (one instance per glyph)
+  void add(GText& text, Texture_Atlas& atlas, glm::vec4 tint);   // graphics thread
+  void add(const Instance& instance);   // graphics thread
+  void flush(Render_Context& context, Texture_Atlas& atlas, program_type program = p_sprite);   // graphics thread (draws & empties the batch)
+  void clear();   // graphics thread
+  
+  static const std::string vert_shader;
+  static const std::string frag_shader;
+  
+private:
+  GLuint instance_buffer, vertex_array_object;
+  bool buffers_ready = false;
+  std::vector<Instance> instances;   // this batch
+  
+  void setup_buffers(Render_Context& context);
+  void delete_buffers();
+};
@@ -0,0 +1,282 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "static_batch.h"
+
+#include <exception>
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Static_Batch::Static_Batch(){}
+
+
+
+//------------------------------------------------------------------------------
+Static_Batch::~Static_Batch(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::add(id gobj_id, std::shared_ptr<GShape> shape, bool pinned){
+  if(chunk_of.contains(gobj_id))
+    remove(gobj_id);
+  
+  // first chunk of the shape's layer with free space
+  int layer = shape->get_layer();
+  auto& chunks = layers[layer];
+  std::size_t c = 0;
+  while(c < chunks.size() && chunks[c]->shapes.size() >= chunk_capacity)
+    c++;
+  if(c == chunks.size()){
+    chunks.push_back( std::make_unique<Chunk>() );
+    chunks[c]->layer = layer;
+  }
+  
+  Chunk& chunk = *chunks[c];
+  chunk.shapes.insert( {gobj_id, shape} );
+  chunk.dirty = true;
+  chunk.unsorted = true;
+  chunk_of.insert( {gobj_id, &chunk} );
+  this->pinned.insert( {gobj_id, pinned} );
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr<GShape> Static_Batch::remove(id gobj_id){
+  auto c = chunk_of.find(gobj_id);
+  if(c == chunk_of.end())
+    return nullptr;
+  
+  Chunk& chunk = *c->second;
+  auto shape = chunk.shapes.at(gobj_id);
+  chunk.shapes.erase(gobj_id);
+  chunk.dirty = true;
+  chunk.unsorted = true;
+  
+  chunk_of.erase(c);
+  pinned.erase(gobj_id);
+  return shape;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr<GShape> Static_Batch::get(id gobj_id){
+  auto c = chunk_of.find(gobj_id);
+  if(c == chunk_of.end())
+    return nullptr;
+  
+  return c->second->shapes.at(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Static_Batch::is_pinned(id gobj_id){
+  auto p = pinned.find(gobj_id);
+  return p != pinned.end() && p->second;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::touch(id gobj_id){
+  auto c = chunk_of.find(gobj_id);
+  if(c == chunk_of.end())
+    return;
+  
+  Chunk& chunk = *c->second;
+  auto shape = chunk.shapes.at(gobj_id);
+  if(shape->get_layer() != chunk.layer){   // re-layered -> belongs to another chunk
+    add(gobj_id, shape, is_pinned(gobj_id));
+    return;
+  }
+  
+  chunk.dirty = true;
+  chunk.unsorted = true;   // depth may have changed
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::clear(){
+  for(auto &layer : layers)
+    for(auto &c : layer.second)
+      delete_buffers(*c);
+  
+  layers.clear();
+  chunk_of.clear();
+  pinned.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::get_layers(std::vector<int>& layers){
+  layers.clear();
+  for(auto &layer : this->layers)
+    for(auto &c : layer.second)
+      if( !c->shapes.empty() ){
+        layers.push_back(layer.first);
+        break;
+      }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::render(Render_Context& context, int layer){
+  auto chunks = layers.find(layer);
+  if(chunks == layers.end())
+    return;
+  
+  auto shader_program = context.use_program(p_shape);
+  shader_program->set_uni("model", glm::mat4(1.0f));   // geometry is already transformed
+  shader_program->set_uni("uni_color", 0.0f, 0.0f, 0.0f, 0.0f);
+  
+  for(auto &c : chunks->second){
+    if(c->dirty)
+      bake(*c, context);
+    
+    if(c->index_count == 0)
+      continue;
+    
+    context.bind_vertex_array(c->vertex_array_object);
+    context.draw_elements(GL_TRIANGLES, c->index_count);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Static_Batch::size(){
+  return chunk_of.size();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::for_each(const std::function< void(id, GShape&) >& func){
+  for(auto &layer : layers)
+    for_each(layer.first, func);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::for_each(int layer, const std::function< void(id, GShape&) >& func){
+  auto chunks = layers.find(layer);
+  if(chunks == layers.end())
+    return;
+  
+  for(auto &chunk : chunks->second){
+    if(chunk->unsorted)
+      sort(*chunk);
+    
+    for(auto &shape : chunk->order)
+      func(shape.first, *shape.second);
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Static_Batch::sort(Chunk& chunk){
+  chunk.order.clear();
+  for(auto &s : chunk.shapes)   // by id
+    chunk.order.push_back( {s.first, s.second.get()} );
+  
+  // same z-order as the render queue (depth within the layer), ties stay by id
+  std::stable_sort(chunk.order.begin(), chunk.order.end(), [](const auto& a, const auto& b){
+    return a.second->get_sort_key() < b.second->get_sort_key();
+  });
+  
+  chunk.unsorted = false;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::bake(Chunk& chunk, Render_Context& context){
+  std::vector<Vertex> vertices;
+  std::vector<Index3> indices;
+  
+  if(chunk.unsorted)
+    sort(chunk);
+  for(auto &s : chunk.order)
+    s.second->bake(vertices, indices);
+  
+  if( ! chunk.buffers_ready){
+    glGenVertexArrays(1, &chunk.vertex_array_object);
+    context.bind_vertex_array(chunk.vertex_array_object);
+    
+    glGenBuffers(1, &chunk.vertex_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vertex_buffer);
+    glGenBuffers(1, &chunk.element_buffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk.element_buffer);
+    
+    // same layout as GMesh
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(glm::vec3));
+    glEnableVertexAttribArray(1);
+    
+    chunk.buffers_ready = true;
+  }
+  
+  context.bind_vertex_array(chunk.vertex_array_object);
+  glBindBuffer(GL_ARRAY_BUFFER, chunk.vertex_buffer);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(Index3), indices.data(), GL_STATIC_DRAW);   // element buffer is part of the vertex array object
+  
+  chunk.index_count = indices.size() * 3;
+  chunk.dirty = false;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Static_Batch::delete_buffers(Chunk& chunk){
+  if( ! chunk.buffers_ready)
+    return;
+  
+  glDeleteVertexArrays(1, &chunk.vertex_array_object);
+  glDeleteBuffers(1, &chunk.vertex_buffer);
+  glDeleteBuffers(1, &chunk.element_buffer);
+  chunk.buffers_ready = false;
+}
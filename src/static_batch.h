@@ -0,0 +1,86 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include "render_context.h"
+#include "graphics_object.h"
+#include "utils.h"
+
+
+
+//------------------------------------------------------------------------------
+// GShapes that don't move, baked (pre-transformed) into merged buffers;
+// shapes are grouped into chunks per layer so a change only re-bakes one chunk
+// and every layer can be drawn right before the dynamic objects of that layer
+class Static_Batch{
+public:
+  Static_Batch();
+  ~Static_Batch();
+  void add(id gobj_id, std::shared_ptr<GShape> shape, bool pinned);   // graphics thread
+  std::shared_ptr<GShape> remove(id gobj_id);   // graphics thread (returns nullptr if not baked)
+  std::shared_ptr<GShape> get(id gobj_id);   // graphics thread (returns nullptr if not baked)
+  bool is_pinned(id gobj_id);   // graphics thread
+  void touch(id gobj_id);   // graphics thread (shape changed -> re-bake its chunk; moves it if its layer changed)
+  void clear();   // graphics thread
+  void get_layers(std::vector<int>& layers);   // graphics thread (ascending; only layers holding shapes)
+  void render(Render_Context& context, int layer);   // graphics thread
+  std::size_t size();
+  void for_each(const std::function< void(id, GShape&) >& func);   // graphics thread (in draw order)
+  void for_each(int layer, const std::function< void(id, GShape&) >& func);   // graphics thread (in draw order)
+  
+private:
+  struct Chunk{
+    int layer = 0;
+    std::map< id, std::shared_ptr<GShape> > shapes;
+    std::vector< std::pair< id, GShape* > > order;   // draw order: sort key, then id (deterministic overlap)
+    GLuint vertex_buffer, vertex_array_object, element_buffer;
+    std::size_t index_count = 0;
+    bool buffers_ready = false;
+    bool dirty = true;   // buffers outdated
+    bool unsorted = true;   // order outdated
+  };
+  
+  const std::size_t chunk_capacity = 1024;   // shapes per chunk
+  std::map< int, std::vector< std::unique_ptr<Chunk> > > layers;   // ascending -> draw order
+  std::unordered_map< id, Chunk* > chunk_of;
+  std::unordered_map< id, bool > pinned;   // explicitly marked static (stay baked when moved)
+  
+  void sort(Chunk& chunk);
+  void bake(Chunk& chunk, Render_Context& context);
+  void delete_buffers(Chunk& chunk);
+};
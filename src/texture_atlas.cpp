@@ -0,0 +1,271 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "texture_atlas.h"
+
+#include <exception>
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Texture_Atlas::Texture_Atlas(){}
+
+
+
+//------------------------------------------------------------------------------
+Texture_Atlas::~Texture_Atlas(){
+  clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Texture_Atlas::add(std::uint64_t image_id, std::shared_ptr< const Image_Data > image){
+  std::size_t width = image->width + padding;
+  std::size_t height = image->height + padding;
+  if(width > page_size || height > page_size)
+    throw std::runtime_error("Texture_Atlas: Image is larger than an atlas page!");
+  
+  // first page with enough space
+  std::size_t p = 0;
+  std::size_t x, y;
+  while(p < pages.size() && ! pack(pages[p], width, height, x, y))
+    p++;
+  if(p == pages.size()){
+    Page page;
+    page.skyline.push_back( {0, 0, page_size} );
+    pages.push_back(page);
+    pack(pages[p], width, height, x, y);
+  }
+  pages[p].used_area += image->width * image->height;
+  
+  Entry entry;
+  entry.page = p;
+  entry.uv_rect = glm::vec4(
+    (float)x / page_size,
+    (float)y / page_size,
+    (float)(x + image->width) / page_size,
+    (float)(y + image->height) / page_size
+  );
+  entry.width = image->width;
+  entry.height = image->height;
+  
+  entries.insert_or_assign(image_id, entry);
+  pending.push_back( {entry, image} );
+}
+
+
+
+//------------------------------------------------------------------------------
+const Texture_Atlas::Entry* Texture_Atlas::get(std::uint64_t image_id){
+  auto e = entries.find(image_id);
+  if(e == entries.end())
+    return nullptr;
+  
+  return &e->second;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Texture_Atlas::upload(Render_Context& context){
+  if(pending.empty())
+    return;
+  
+  if(allocated_pages < pages.size())
+    grow_texture(context);
+  
+  context.bind_texture_array(texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  for(auto &p : pending){
+    const Entry& entry = p.first;
+    glTexSubImage3D(
+      GL_TEXTURE_2D_ARRAY, 0,
+      entry.uv_rect.x * page_size, entry.uv_rect.y * page_size, entry.page,
+      entry.width, entry.height, 1,
+      GL_RGBA, GL_UNSIGNED_BYTE, p.second->pixels.data()
+    );
+  }
+  
+  pending.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Texture_Atlas::bind(Render_Context& context){
+  if(texture_ready)
+    context.bind_texture_array(texture);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Texture_Atlas::clear(){
+  if(texture_ready){
+    glDeleteTextures(1, &texture);
+    texture_ready = false;
+  }
+  
+  allocated_pages = 0;
+  pages.clear();
+  entries.clear();
+  pending.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Texture_Atlas::page_count(){
+  return pages.size();
+}
+
+
+
+//------------------------------------------------------------------------------
+float Texture_Atlas::occupancy(){
+  if(pages.empty())
+    return 0.0f;
+  
+  std::size_t used = 0;
+  for(auto &p : pages)
+    used += p.used_area;
+  
+  return (float)used / (pages.size() * page_size * page_size);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+bool Texture_Atlas::pack(Page& page, std::size_t width, std::size_t height, std::size_t& x, std::size_t& y){
+  // lowest position (then leftmost) at the start of a skyline node
+  std::size_t best = page.skyline.size();
+  std::size_t best_y = page_size;
+  for(std::size_t n = 0; n < page.skyline.size(); n++){
+    std::size_t node_y;
+    if(fits(page, n, width, height, node_y) && node_y < best_y){
+      best = n;
+      best_y = node_y;
+    }
+  }
+  if(best == page.skyline.size())
+    return false;
+  
+  x = page.skyline[best].x;
+  y = best_y;
+  
+  // raise skyline below the new image
+  auto& skyline = page.skyline;
+  skyline.insert(skyline.begin() + best, {x, y + height, width});
+  
+  for(std::size_t n = best + 1; n < skyline.size(); ){
+    std::size_t covered_until = skyline[best].x + skyline[best].width;
+    if(skyline[n].x >= covered_until)
+      break;
+    
+    std::size_t overlap = covered_until - skyline[n].x;
+    if(overlap < skyline[n].width){   // partly covered
+      skyline[n].x += overlap;
+      skyline[n].width -= overlap;
+      break;
+    }
+    skyline.erase(skyline.begin() + n);   // fully covered
+  }
+  
+  // merge neighbours of equal height
+  for(std::size_t n = 0; n + 1 < skyline.size(); ){
+    if(skyline[n].y == skyline[n + 1].y){
+      skyline[n].width += skyline[n + 1].width;
+      skyline.erase(skyline.begin() + n + 1);
+    }
+    else
+      n++;
+  }
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Texture_Atlas::fits(const Page& page, std::size_t node, std::size_t width, std::size_t height, std::size_t& y){
+  std::size_t x = page.skyline[node].x;
+  if(x + width > page_size)
+    return false;
+  
+  // highest skyline below the image
+  y = 0;
+  std::size_t remaining = width;
+  for(std::size_t n = node; remaining > 0; n++){
+    y = std::max(y, page.skyline[n].y);
+    if(y + height > page_size)
+      return false;
+    remaining -= std::min(remaining, page.skyline[n].width);
+  }
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Texture_Atlas::grow_texture(Render_Context& context){
+  std::size_t new_pages = std::max(pages.size(), allocated_pages * 2);
+  
+  GLuint new_texture;
+  glGenTextures(1, &new_texture);
+  context.bind_texture_array(new_texture);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, page_size, page_size, new_pages);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  
+  // storage is immutable -> clear new pages (padding has to be transparent), copy old ones
+  std::vector< std::uint8_t > zeros(page_size * page_size * 4, 0);
+  for(std::size_t p = allocated_pages; p < new_pages; p++)
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, p, page_size, page_size, 1, GL_RGBA, GL_UNSIGNED_BYTE, zeros.data());
+  
+  if(texture_ready){
+    glCopyImageSubData(
+      texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+      new_texture, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0,
+      page_size, page_size, allocated_pages
+    );
+    glDeleteTextures(1, &texture);
+  }
+  
+  texture = new_texture;
+  texture_ready = true;
+  allocated_pages = new_pages;
+}
@@ -0,0 +1,101 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include "render_context.h"
+
+
+
+// image as passed from the API to the graphics thread
+struct Image_Data{
+  std::size_t width;
+  std::size_t height;
+  std::vector< std::uint8_t > pixels;   // r, g, b, a; first row = top
+};
+
+
+
+//------------------------------------------------------------------------------
+// images of one window packed into the pages of a single array texture
+// (skyline packer); sprites on any page can be drawn without rebinding
+class Texture_Atlas{
+public:
+  struct Entry{
+    std::size_t page;
+    glm::vec4 uv_rect;   // u0, v0, u1, v1 (v0 = top)
+    std::size_t width;
+    std::size_t height;
+  };
+  
+  static const std::size_t page_size = 1024;   // pixels (width & height)
+  static const std::size_t padding = 1;   // transparent pixels between images (no bleeding)
+  static const std::size_t max_image_size = page_size - padding;
+  
+  Texture_Atlas();
+  ~Texture_Atlas();
+  void add(std::uint64_t image_id, std::shared_ptr< const Image_Data > image);   // graphics thread
+  const Entry* get(std::uint64_t image_id);   // graphics thread (nullptr if unknown)
+  void upload(Render_Context& context);   // graphics thread (new pages & images)
+  void bind(Render_Context& context);   // graphics thread
+  void clear();   // graphics thread
+  std::size_t page_count();
+  float occupancy();   // packed area / area of all pages
+  
+private:
+  struct Skyline_Node{
+    std::size_t x;
+    std::size_t y;   // height of skyline from x to x + width
+    std::size_t width;
+  };
+  
+  struct Page{
+    std::vector<Skyline_Node> skyline;   // sorted by x, covers the whole page width
+    std::size_t used_area = 0;
+  };
+  
+  GLuint texture;
+  bool texture_ready = false;
+  std::size_t allocated_pages = 0;
+  std::vector<Page> pages;
+  std::unordered_map< std::uint64_t, Entry > entries;
+  std::vector< std::pair< Entry, std::shared_ptr< const Image_Data > > > pending;   // uploaded on next render
+  
+  bool pack(Page& page, std::size_t width, std::size_t height, std::size_t& x, std::size_t& y);
+  bool fits(const Page& page, std::size_t node, std::size_t width, std::size_t height, std::size_t& y);
+  void grow_texture(Render_Context& context);
+};
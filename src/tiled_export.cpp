@@ -0,0 +1,154 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#include "tiled_export.h"
+
+#include <algorithm>
+#include <exception>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Tiled_Export::Tiled_Export(const std::string& path, std::size_t width, std::size_t height)
+  : width(width), height(height){
+  
+  file.open(path, std::ios::binary | std::ios::trunc);
+  if( ! file)
+    throw std::runtime_error("export_image(): Could not open " + path + "!");
+  
+  file << "P6\n" << width << " " << height << "\n255\n";
+  header_size = file.tellp();
+  
+  GLint max_texture, max_renderbuffer;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture);
+  glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &max_renderbuffer);
+  tile_size = std::min( {max_tile_size, max_texture, max_renderbuffer} );
+  
+  setup_framebuffer();
+  pixels.resize( (std::size_t)tile_size * tile_size * 3 );
+}
+
+
+
+//------------------------------------------------------------------------------
+Tiled_Export::~Tiled_Export(){
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glDeleteFramebuffers(1, &framebuffer);
+  glDeleteTextures(1, &colour_texture);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Tiled_Export::begin_tile(glm::vec4& region, float& pixel_scale, float screen_width){
+  // row by row, left to right
+  if(started){
+    tile_x += tile_size;
+    if(tile_x >= width){
+      tile_x = 0;
+      tile_y += tile_size;
+    }
+  }
+  started = true;
+  
+  if(tile_y >= height)
+    return false;
+  
+  tile_width = std::min<std::size_t>(tile_size, width - tile_x);
+  tile_height = std::min<std::size_t>(tile_size, height - tile_y);
+  
+  // part of the window's view this tile covers
+  region = glm::vec4(
+    (float)tile_x / width,
+    (float)tile_y / height,
+    (float)(tile_x + tile_width) / width,
+    (float)(tile_y + tile_height) / height
+  );
+  pixel_scale = (float)width / screen_width;
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, tile_width, tile_height);
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tiled_Export::end_tile(){
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glReadPixels(0, 0, tile_width, tile_height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+  
+  // GL rows start at the bottom, PPM rows at the top
+  std::size_t row_bytes = (std::size_t)tile_width * 3;
+  for(int row = 0; row < tile_height; row++){
+    std::size_t y = tile_y + (tile_height - 1 - row);
+    file.seekp( header_size + (std::streamoff)((y * width + tile_x) * 3) );
+    file.write( (const char*)pixels.data() + row * row_bytes, row_bytes );
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tiled_Export::finish(){
+  file.flush();
+  if( ! file)
+    throw std::runtime_error("export_image(): Writing the image failed!");
+  
+  file.close();
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Tiled_Export::setup_framebuffer(){
+  glGenTextures(1, &colour_texture);
+  glBindTexture(GL_TEXTURE_2D, colour_texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, tile_size, tile_size);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colour_texture, 0);
+  
+  if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &colour_texture);
+    throw std::runtime_error("export_image(): Tile framebuffer is incomplete!");
+  }
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
@@ -0,0 +1,80 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <future>
+#include <cstdint>
+
+///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
+// #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+
+
+// one export of the API
+struct Export_Request{
+  std::string path;
+  std::size_t width, height;   // pixels
+  std::promise< void > done;
+};
+
+
+
+//------------------------------------------------------------------------------
+// renders an image of any size tile by tile into an offscreen framebuffer and
+// writes every tile straight to its place in a binary PPM file -> memory use
+// is bounded by one tile, not by the image
+class Tiled_Export{
+public:
+  Tiled_Export(const std::string& path, std::size_t width, std::size_t height);   // graphics thread (throws std::runtime_error)
+  ~Tiled_Export();   // graphics thread (context has to be current)
+  bool begin_tile(glm::vec4& region, float& pixel_scale, float screen_width);   // graphics thread (false when done; binds tile framebuffer)
+  void end_tile();   // graphics thread (reads tile back & writes it)
+  void finish();   // graphics thread (throws std::runtime_error on write errors)
+  
+private:
+  static constexpr GLint max_tile_size = 4096;
+  
+  std::ofstream file;
+  std::streamoff header_size;
+  std::size_t width, height;
+  GLint tile_size;
+  std::size_t tile_x = 0, tile_y = 0;   // current tile (pixels, origin top left)
+  int tile_width = 0, tile_height = 0;
+  bool started = false;
+  
+  GLuint framebuffer, colour_texture;
+  std::vector< std::uint8_t > pixels;   // one tile
+  
+  void setup_framebuffer();
+};
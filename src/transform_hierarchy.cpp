@@ -0,0 +1,242 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Transform_Hierarchy::Transform_Hierarchy(){}
+
+
+
+//------------------------------------------------------------------------------
+Transform_Hierarchy::~Transform_Hierarchy(){}
+
+
+
+//------------------------------------------------------------------------------
+bool Transform_Hierarchy::set_parent(
+  std::uint64_t child_id, std::shared_ptr<GObject> child,
+  std::uint64_t parent_id, std::shared_ptr<GObject> parent)
+{
+  if(child_id == parent_id || is_ancestor(child_id, parent_id))
+    return false;
+  
+  if(nodes.contains(child_id) && nodes.at(child_id).has_parent){
+    Node& old_parent = nodes.at( nodes.at(child_id).parent );
+    std::erase(old_parent.children, child_id);
+    erase_if_unrelated( nodes.at(child_id).parent );
+  }
+  
+  Node& p = nodes[parent_id];
+  p.obj = parent;
+  p.children.push_back(child_id);
+  
+  Node& c = nodes[child_id];
+  c.obj = child;
+  c.has_parent = true;
+  c.parent = parent_id;
+  
+  child->parented = true;   // position is now relative to parent
+  order_dirty = true;
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::remove_parent(std::uint64_t child_id){
+  auto c = nodes.find(child_id);
+  if(c == nodes.end() || ! c->second.has_parent)
+    return;
+  
+  std::uint64_t parent_id = c->second.parent;
+  std::erase(nodes.at(parent_id).children, child_id);
+  detach(child_id);
+  
+  erase_if_unrelated(parent_id);
+  erase_if_unrelated(child_id);
+  order_dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::remove(std::uint64_t node_id){
+  auto n = nodes.find(node_id);
+  if(n == nodes.end())
+    return;
+  
+  for(auto child_id : n->second.children){
+    detach(child_id);
+    erase_if_unrelated(child_id);
+  }
+  
+  if(n->second.has_parent){
+    std::uint64_t parent_id = n->second.parent;
+    std::erase(nodes.at(parent_id).children, node_id);
+    erase_if_unrelated(parent_id);
+  }
+  
+  nodes.erase(node_id);
+  order_dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::clear(){
+  for(auto &n : nodes)
+    n.second.obj->parented = false;
+  
+  nodes.clear();
+  order_dirty = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::update(){
+  changed.clear();
+  
+  bool all = order_dirty;   // relations changed -> recompute everything once
+  if(order_dirty)
+    rebuild_order();
+  
+  // parents come first -> one linear pass
+  for(std::size_t i = 0; i < order_objs.size(); i++){
+    GObject* obj = order_objs[i];
+    int p = order_parents[i];
+    
+    dirty[i] = all || obj->transform_changed || (p >= 0 && dirty[p]);
+    if( ! dirty[i])
+      continue;
+    obj->transform_changed = false;
+    
+    glm::mat4 local = glm::translate(glm::mat4(1.0f), obj->get_position());
+    local = glm::rotate(local, glm::radians(obj->get_rotation()), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+    
+    if(p < 0){   // root: world transform = own transform
+      world_matrices[i] = local;
+      world_rotations[i] = obj->get_rotation();
+      continue;
+    }
+    
+    world_matrices[i] = world_matrices[p] * local;
+    world_rotations[i] = world_rotations[p] + obj->get_rotation();
+    obj->set_world_transform( glm::vec3(world_matrices[i][3]), world_rotations[i] );
+    changed.push_back(order_ids[i]);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+const std::vector< std::uint64_t >& Transform_Hierarchy::get_changed(){
+  return changed;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Transform_Hierarchy::detach(std::uint64_t child_id){
+  Node& c = nodes.at(child_id);
+  GObject* obj = c.obj.get();
+  
+  glm::vec3 world_position = obj->get_world_position();
+  float world_rotation = obj->get_world_rotation();
+  
+  c.has_parent = false;
+  obj->parented = false;
+  obj->set_position(world_position);   // relative to world now
+  obj->set_rotation(world_rotation);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::erase_if_unrelated(std::uint64_t node_id){
+  auto n = nodes.find(node_id);
+  if(n != nodes.end() && ! n->second.has_parent && n->second.children.empty())
+    nodes.erase(n);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Transform_Hierarchy::is_ancestor(std::uint64_t ancestor_id, std::uint64_t node_id){
+  auto n = nodes.find(node_id);
+  while(n != nodes.end() && n->second.has_parent){
+    if(n->second.parent == ancestor_id)
+      return true;
+    n = nodes.find(n->second.parent);
+  }
+  
+  return false;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Transform_Hierarchy::rebuild_order(){
+  order_ids.clear();
+  order_objs.clear();
+  order_parents.clear();
+  
+  // depth-first from every root
+  std::vector< std::pair< std::uint64_t, int > > stack;   // node, index of parent
+  for(auto &n : nodes)
+    if( ! n.second.has_parent)
+      stack.push_back( {n.first, -1} );
+  
+  while( ! stack.empty() ){
+    auto [node_id, parent_index] = stack.back();
+    stack.pop_back();
+    
+    const Node& node = nodes.at(node_id);
+    int index = order_ids.size();
+    order_ids.push_back(node_id);
+    order_objs.push_back(node.obj.get());
+    order_parents.push_back(parent_index);
+    
+    for(auto child_id : node.children)
+      stack.push_back( {child_id, index} );
+  }
+  
+  world_matrices.resize(order_ids.size());
+  world_rotations.resize(order_ids.size());
+  dirty.resize(order_ids.size());
+  order_dirty = false;
+}
@@ -0,0 +1,84 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "graphics_object.h"
+
+
+
+//------------------------------------------------------------------------------
+// parent/child relations of graphics_objects of one window; children keep
+// their transform relative to the parent, world matrices are cached in arrays
+// ordered parents-before-children & only recomputed below changed nodes
+class Transform_Hierarchy{
+public:
+  Transform_Hierarchy();
+  ~Transform_Hierarchy();
+  bool set_parent(
+    std::uint64_t child_id, std::shared_ptr<GObject> child,
+    std::uint64_t parent_id, std::shared_ptr<GObject> parent
+  );   // false if this would create a cycle
+  void remove_parent(std::uint64_t child_id);   // child keeps its world transform
+  void remove(std::uint64_t node_id);   // children keep their world transform
+  void clear();
+  void update();   // graphics thread (once per frame)
+  const std::vector< std::uint64_t >& get_changed();   // world transform changed in last update()
+  
+private:
+  struct Node{
+    std::shared_ptr<GObject> obj;
+    bool has_parent = false;
+    std::uint64_t parent;
+    std::vector< std::uint64_t > children;
+  };
+  
+  std::unordered_map< std::uint64_t, Node > nodes;   // only objects with parent and/or children
+  
+  // topological order (rebuilt when relations change)
+  bool order_dirty = false;
+  std::vector< std::uint64_t > order_ids;
+  std::vector< GObject* > order_objs;
+  std::vector< int > order_parents;   // index into order arrays; -1 = root
+  std::vector< glm::mat4 > world_matrices;
+  std::vector< float > world_rotations;   // degrees
+  std::vector< std::uint8_t > dirty;
+  
+  std::vector< std::uint64_t > changed;
+  
+  void detach(std::uint64_t child_id);   // keeps world transform
+  void erase_if_unrelated(std::uint64_t node_id);
+  bool is_ancestor(std::uint64_t ancestor_id, std::uint64_t node_id);
+  void rebuild_order();
+};
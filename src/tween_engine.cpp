@@ -0,0 +1,184 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#include "tween_engine.h"
+
+#include <algorithm>
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// public
+////////////////////////////////////////////////////////////////////////////////
+
+Tween_Engine::Tween_Engine(){}
+
+
+
+//------------------------------------------------------------------------------
+Tween_Engine::~Tween_Engine(){}
+
+
+
+//------------------------------------------------------------------------------
+void Tween_Engine::add(std::uint64_t target, tween_property property, glm::vec3 start, glm::vec3 end, float duration, easing ease){
+  if(is_camera(property))
+    target = 0;
+  
+  for(std::size_t i = 0; i < targets.size(); i++)
+    if(targets[i] == target && properties[i] == property){
+      remove(i);
+      break;
+    }
+  
+  targets.push_back(target);
+  properties.push_back(property);
+  starts.push_back(start);
+  ends.push_back(end);
+  elapsed.push_back(0.0f);
+  durations.push_back(duration);
+  eases.push_back(ease);
+  values.push_back(start);
+  finished.push_back(false);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tween_Engine::remove_target(std::uint64_t target){
+  for(std::size_t i = 0; i < targets.size(); )
+    if(targets[i] == target && ! is_camera(properties[i]))
+      remove(i);
+    else
+      i++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tween_Engine::clear_targets(){
+  for(std::size_t i = 0; i < targets.size(); )
+    if( ! is_camera(properties[i]) )
+      remove(i);
+    else
+      i++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tween_Engine::update(float delta_time){
+  remove_finished();   // their end values were applied last frame
+  
+  for(std::size_t i = 0; i < targets.size(); i++){
+    elapsed[i] += delta_time;
+    float t = durations[i] > 0.0f ? std::min(elapsed[i] / durations[i], 1.0f) : 1.0f;
+    values[i] = glm::mix(starts[i], ends[i], ease(eases[i], t));
+    finished[i] = (t >= 1.0f);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Tween_Engine::size(){
+  return targets.size();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::uint64_t Tween_Engine::get_target(std::size_t i){  return targets[i];  }
+
+
+
+//------------------------------------------------------------------------------
+tween_property Tween_Engine::get_property(std::size_t i){  return properties[i];  }
+
+
+
+//------------------------------------------------------------------------------
+glm::vec3 Tween_Engine::get_value(std::size_t i){  return values[i];  }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// private
+////////////////////////////////////////////////////////////////////////////////
+
+void Tween_Engine::remove_finished(){
+  for(std::size_t i = 0; i < targets.size(); )
+    if(finished[i])
+      remove(i);
+    else
+      i++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Tween_Engine::remove(std::size_t i){
+  std::size_t last = targets.size() - 1;
+  
+  targets[i] = targets[last];
+  properties[i] = properties[last];
+  starts[i] = starts[last];
+  ends[i] = ends[last];
+  elapsed[i] = elapsed[last];
+  durations[i] = durations[last];
+  eases[i] = eases[last];
+  values[i] = values[last];
+  finished[i] = finished[last];
+  
+  targets.pop_back();
+  properties.pop_back();
+  starts.pop_back();
+  ends.pop_back();
+  elapsed.pop_back();
+  durations.pop_back();
+  eases.pop_back();
+  values.pop_back();
+  finished.pop_back();
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Tween_Engine::is_camera(tween_property property){
+  return property == tw_camera_position || property == tw_camera_zoom;
+}
+
+
+
+//------------------------------------------------------------------------------
+float Tween_Engine::ease(easing e, float t){
+  switch(e){
+  case e_ease_in:     return t * t;
+  case e_ease_out:    return 1.0f - (1.0f - t) * (1.0f - t);
+  case e_ease_in_out: return t * t * (3.0f - 2.0f * t);   // smoothstep
+  default:            return t;   // linear
+  }
+}
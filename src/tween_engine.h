@@ -0,0 +1,89 @@
+/*
+
+MIT License
+
+Copyright (c) 2022 the_green_penguin
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+
+*/
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+
+
+// used by API
+enum easing{
+  e_linear,
+  e_ease_in,
+  e_ease_out,
+  e_ease_in_out
+};
+
+
+
+enum tween_property{
+  tw_position,
+  tw_rotation,   // x
+  tw_scale,   // x
+  tw_colour,
+  tw_camera_position,
+  tw_camera_zoom   // x
+};
+
+
+
+//------------------------------------------------------------------------------
+// running animations of one window; all tweens are advanced in one pass over
+// flat arrays, the owner then applies the resulting values
+class Tween_Engine{
+public:
+  Tween_Engine();
+  ~Tween_Engine();
+  void add(std::uint64_t target, tween_property property, glm::vec3 start, glm::vec3 end, float duration, easing ease);   // replaces tween of same target & property
+  void remove_target(std::uint64_t target);
+  void clear_targets();   // keeps camera tweens
+  void update(float delta_time);   // seconds
+  std::size_t size();
+  std::uint64_t get_target(std::size_t i);
+  tween_property get_property(std::size_t i);
+  glm::vec3 get_value(std::size_t i);   // valid after update()
+  
+private:
+  // one element per tween
+  std::vector< std::uint64_t > targets;
+  std::vector< tween_property > properties;
+  std::vector< glm::vec3 > starts;
+  std::vector< glm::vec3 > ends;
+  std::vector< float > elapsed;
+  std::vector< float > durations;
+  std::vector< easing > eases;
+  std::vector< glm::vec3 > values;
+  std::vector< std::uint8_t > finished;   // end value reached (applied once more, then removed)
+  
+  void remove_finished();
+  void remove(std::size_t i);   // swaps with last
+  static bool is_camera(tween_property property);
+  static float ease(easing e, float t);
+};
@@ -31,10 +31,16 @@ SOFTWARE.
 #include <memory>
 #include <variant>
 #include <tuple>
+#include <vector>
+#include <future>
 
 #include <glm/glm.hpp>
 
 #include "graphics_object.h"
+#include "graphics_point_set.h"
+#include "texture_atlas.h"
+#include "tween_engine.h"
+#include "shared_scene.h"
 
 
 
@@ -43,13 +49,103 @@ typedef uint microsecs;
 
 
 
+struct Pick_Request;   // picker.h (needs id)
+struct Export_Request;   // tiled_export.h
+struct Snapshot_Request;   // scene_snapshot.h
+class Scene_Snapshot;   // scene_snapshot.h
+
+
+
+// used by API
+enum gobj_type{
+  t_triangle,
+  t_rectangle,
+  t_circle
+};
+
+
+
+// used by API
+enum render_backend{
+  rb_opengl,
+  rb_software   // CPU rasterizer; no GLFW window, frames only reachable through capture()
+};
+
+
+
+// used by API
+enum queue_policy{
+  q_block,   // wait until the graphics thread has drained the queue
+  q_fail,   // throw std::runtime_error
+  q_drop   // drop superseded, then oldest coalescable updates (throws if none left)
+};
+
+
+
+// message queue metrics (API -> graphics thread)
+struct Queue_Stats{
+  std::size_t depth = 0;
+  std::size_t high_water = 0;   // since last set_queue_capacity()
+  std::size_t capacity = 0;   // 0 = unbounded
+  std::size_t enqueued = 0;
+  std::size_t dropped = 0;
+  std::size_t rejected = 0;
+  double wait_total = 0.0;   // seconds spent enqueueing (lock + blocking)
+  double wait_max = 0.0;   // seconds
+};
+
+
+
+// everything the graphics thread needs to build a graphics_object
+struct GObject_Descriptor{
+  gobj_type type;
+  glm::vec3 position;
+  float rotation;   // degrees
+  float size;
+  glm::vec3 colour;
+};
+
+
+
+struct Text_Descriptor{
+  std::string text;
+  glm::vec3 position;
+  float size;   // glyph height
+  glm::vec3 colour;
+};
+
+
+
+struct Tween_Descriptor{
+  tween_property property;
+  glm::vec3 target;   // only x used for rotation, scale & zoom
+  float duration;   // seconds
+  easing ease;
+};
+
+
+
+struct Sprite_Descriptor{
+  id image;
+  glm::vec3 position;
+  float rotation;   // degrees
+  float size;   // width
+};
+
+
+
+// one capture of the API
+struct Capture_Request{
+  std::promise< Image_Data > result;
+};
+
+
+
 struct Thread_Message{
   // type
   enum msg_type{
     open_win,
     close_win,
-    got_closed,
-    count_win,
     add_gobject,
     remove_gobject,
     clear_gobjects,
@@ -60,8 +156,34 @@ struct Thread_Message{
     mod_camera_zoom,
     set_allow_zoom,
     set_allow_camera_movement,
+    set_camera_inertia,
     set_background_colour,
-    set_window_name
+    set_window_name,
+    add_polyline,
+    append_points,
+    add_point_set,
+    update_points,
+    set_gobj_static,
+    set_auto_static,
+    set_gobj_layer,
+    add_image,
+    add_sprite,
+    add_text,
+    set_text,
+    animate,
+    set_gobj_velocity,
+    set_gobj_acceleration,
+    set_gobj_angular_velocity,
+    add_group,
+    set_gobj_parent,
+    remove_gobj_parent,
+    share_scene,
+    pick,
+    export_image,
+    save_snapshot,
+    load_snapshot,
+    capture,
+    set_render_thread
   } type;
   
   // parameters
@@ -70,12 +192,33 @@ struct Thread_Message{
     std::size_t,
     std::string,
     std::tuple<id, bool>,
+    std::tuple<id, std::size_t>,
     std::tuple<id, float>,
     std::tuple<id, id>,
     std::tuple<id, glm::vec3>,
     std::tuple<id, std::string>,
+    std::tuple<id, id, bool>,
+    std::tuple<id, id, int>,
     std::tuple<id, id, float>,
+    std::tuple<id, id, glm::vec2>,
     std::tuple<id, id, glm::vec3>,
-    std::tuple<id, id, std::shared_ptr< GShape > >
+    std::tuple<id, id, id>,
+    std::tuple<id, id, glm::vec3, float>,
+    std::tuple<id, id, GObject_Descriptor>,
+    std::tuple<id, id, float, glm::vec3, std::size_t>,
+    std::tuple<id, id, std::vector< glm::vec2 > >,
+    std::tuple<id, id, std::shared_ptr< const Point_Data > >,
+    std::tuple<id, id, std::shared_ptr< const Image_Data > >,
+    std::tuple<id, id, Sprite_Descriptor>,
+    std::tuple<id, id, Text_Descriptor>,
+    std::tuple<id, id, Tween_Descriptor>,
+    std::tuple<id, id, std::string>,
+    std::tuple<id, std::shared_ptr< Shared_Scene > >,
+    std::tuple<id, std::shared_ptr< Pick_Request > >,
+    std::tuple<id, std::shared_ptr< Export_Request > >,
+    std::tuple<id, std::shared_ptr< Snapshot_Request > >,
+    std::tuple<id, std::shared_ptr< Scene_Snapshot > >,
+    std::tuple<id, std::string, render_backend>,
+    std::tuple<id, std::shared_ptr< Capture_Request > >
   > parameters;
 };
\ No newline at end of file
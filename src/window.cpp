@@ -29,11 +29,19 @@ SOFTWARE.
 
 #include <iostream>
 #include <exception>
+#include <algorithm>
+#include <limits>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 
 
 void glfw_error(int error, const char* description);
 void scroll_callback(GLFWwindow* window, double x_offset, double y_offset);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+void cursor_callback(GLFWwindow* window, double x, double y);
 void APIENTRY glDebugOutput(GLenum source, GLenum type, uint id, GLenum severity, GLsizei length, const char *message, const void *userParam);
 
 
@@ -50,9 +58,19 @@ id Window::open(){
 
 //------------------------------------------------------------------------------
 id Window::open(const std::string& name){
+  return open(name, rb_opengl);
+}
+
+
+
+//------------------------------------------------------------------------------
+id Window::open(const std::string& name, render_backend backend){
+  if(backend == rb_opengl  &&  !Manager::get_instance().has_glfw())
+    throw std::runtime_error("Window::open(): GLFW initialization failed! (use rb_software)");
+  
   id win_id = Manager::get_next_win_id();
   
-  Thread_Message msg = { Thread_Message::open_win, std::make_tuple(win_id, name) };
+  Thread_Message msg = { Thread_Message::open_win, std::make_tuple(win_id, name, backend) };
   Manager::push_msg_from_API(msg);
   
   return win_id;
@@ -70,7 +88,7 @@ void Window::close(id win_id){
 
 //------------------------------------------------------------------------------
 bool Window::got_closed(id win_id){
-  Manager::process_msgs_to_API();   // update Manager
+  flush_commands();   // e.g. close() must be sent before waiting for got_closed()
   return Manager::get_instance().win_got_closed(win_id);
 }
 
@@ -78,44 +96,76 @@ bool Window::got_closed(id win_id){
 
 //------------------------------------------------------------------------------
 std::size_t Window::count(){
-  Manager::process_msgs_to_API();   // update Manager
+  flush_commands();
   return Manager::get_instance().get_count();
 }
 
 
 
 //------------------------------------------------------------------------------
-id Window::add_gobject(id win_id, gobj_type g_type, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > gobject = Manager::new_gobject(g_type, size, colour);
-  id gobj_id = Manager::get_next_gobj_id();
+bool Window::wait_closed(id win_id, std::chrono::milliseconds timeout){
+  flush_commands();
+  auto& manager = Manager::get_instance();
   
-  Thread_Message msg = { Thread_Message::add_gobject, std::make_tuple(win_id, gobj_id, gobject) };
-  Manager::push_msg_from_API(msg);
+  return manager.wait_lifecycle([&](){ return manager.win_got_closed(win_id); }, timeout);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::wait_all_closed(std::chrono::milliseconds timeout){
+  flush_commands();
+  auto& manager = Manager::get_instance();
   
-  return gobj_id;
+  return manager.wait_lifecycle([&](){ return manager.get_count() == 0; }, timeout);
+}
+
+
+
+//------------------------------------------------------------------------------
+int Window::get_lifecycle_fd(){
+  return Manager::get_instance().get_lifecycle_fd();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Window::poll_events(std::span< Input_Event > events){
+  return Manager::get_instance().poll_events(events);
+}
+
+
+
+//------------------------------------------------------------------------------
+int Window::get_input_fd(){
+  return Manager::get_instance().get_input_fd();
+}
+
+
+
+//------------------------------------------------------------------------------
+id Window::add_gobject(id win_id, gobj_type g_type, float size, glm::vec3 colour){
+  return add_gobject(win_id, g_type, {0.0f, 0.0f, 0.0f}, 0.0f, size, colour);   // set position & rotation to default
 }
 
 
 
 //------------------------------------------------------------------------------
 id Window::add_gobject(id win_id, gobj_type g_type, glm::vec3 position, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > gobject = Manager::new_gobject(g_type, position, size, colour);
-  id gobj_id = Manager::get_next_gobj_id();
-  
-  Thread_Message msg = { Thread_Message::add_gobject, std::make_tuple(win_id, gobj_id, gobject) };
-  Manager::push_msg_from_API(msg);
-  
-  return gobj_id;
+  return add_gobject(win_id, g_type, position, 0.0f, size, colour);   // set rotation to default
 }
 
 
 
 //------------------------------------------------------------------------------
 id Window::add_gobject(id win_id, gobj_type g_type, glm::vec3 position, float rotation, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > gobject = Manager::new_gobject(g_type, position, rotation, size, colour);
+  if(g_type != t_triangle && g_type != t_rectangle && g_type != t_circle)
+    throw std::runtime_error("add_gobject(): Invalid GObject type!");
+  
+  GObject_Descriptor desc = { g_type, position, rotation, size, colour };   // geometry is built by the graphics thread
   id gobj_id = Manager::get_next_gobj_id();
   
-  Thread_Message msg = { Thread_Message::add_gobject, std::make_tuple(win_id, gobj_id, gobject) };
+  Thread_Message msg = { Thread_Message::add_gobject, std::make_tuple(win_id, gobj_id, desc) };
   Manager::push_msg_from_API(msg);
   
   return gobj_id;
@@ -195,6 +245,14 @@ void Window::set_allow_camera_movement(id win_id, bool b){
 
 
 
+//------------------------------------------------------------------------------
+void Window::set_camera_inertia(id win_id, bool b){
+  Thread_Message msg = { Thread_Message::set_camera_inertia, std::make_tuple(win_id, b) };
+  Manager::push_msg_from_API(msg);
+}
+
+
+
 //------------------------------------------------------------------------------
 void Window::set_background_colour(id win_id, glm::vec3 colour){
   Thread_Message msg = { Thread_Message::set_background_colour, std::make_tuple(win_id, colour) };
@@ -211,354 +269,2050 @@ void Window::set_window_name(id win_id, const std::string& name){
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Window private
-////////////////////////////////////////////////////////////////////////////////
-
+//------------------------------------------------------------------------------
+void Window::set_render_thread(id win_id, bool b){
+  Thread_Message msg = { Thread_Message::set_render_thread, std::make_tuple(win_id, b) };
+  Manager::push_msg_from_API(msg);
+}
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Wrapper public
-////////////////////////////////////////////////////////////////////////////////
 
-Window::Wrapper::Wrapper(id w_id){
-  this->w_id = w_id;
+//------------------------------------------------------------------------------
+id Window::add_polyline(id win_id, float thickness, glm::vec3 colour, std::size_t capacity){
+  if(capacity < 2  ||  capacity > GPolyline::max_capacity)   // checked here, the graphics thread must not throw
+    throw std::runtime_error("add_polyline(): Capacity has to be at least 2 (and fit GL vertex indices)!");
   
-  create_glfw_window();
-  enable_gl_debugging();
-  setup_shader_program();
+  id line_id = Manager::get_next_gobj_id();
+  
+  Thread_Message msg = { Thread_Message::add_polyline, std::make_tuple(win_id, line_id, thickness, colour, capacity) };
+  Manager::push_msg_from_API(msg);
+  
+  return line_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-Window::Wrapper::~Wrapper(){
-  glfwDestroyWindow(window);
+void Window::append_points(id win_id, id line_id, std::span< const glm::vec2 > points){
+  std::vector< glm::vec2 > copy(points.begin(), points.end());
+  Thread_Message msg = { Thread_Message::append_points, std::make_tuple(win_id, line_id, std::move(copy)) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::update(){
-  if( glfwWindowShouldClose(window) ){
-    Thread_Message msg = { Thread_Message::close_win, w_id };
-    Manager::push_msg_from_API(msg);
-  }
-    
-  else
-    exe_update();
+id Window::add_point_set(id win_id, std::span< const glm::vec2 > positions, glm::vec3 colour, float size){
+  auto data = std::make_shared< Point_Data >();
+  data->positions.assign(positions.begin(), positions.end());
+  data->default_colour = colour;
+  data->default_size = size;
+  
+  id set_id = Manager::get_next_gobj_id();
+  Thread_Message msg = { Thread_Message::add_point_set, std::make_tuple(win_id, set_id, std::shared_ptr< const Point_Data >(data)) };
+  Manager::push_msg_from_API(msg);
+  
+  return set_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::update_name(const std::string& name){
-  window_name = name;
-  glfwSetWindowTitle(window, name.c_str());
+id Window::add_point_set(id win_id, std::span< const glm::vec2 > positions, std::span< const glm::vec3 > colours, std::span< const float > sizes, glm::vec3 default_colour, float default_size){
+  // empty span -> default for all points
+  if( (!colours.empty() && colours.size() != positions.size())  ||  (!sizes.empty() && sizes.size() != positions.size()) )
+    throw std::runtime_error("add_point_set(): Colour/size count has to match position count (or be 0)!");
+  
+  auto data = std::make_shared< Point_Data >();
+  data->positions.assign(positions.begin(), positions.end());
+  data->colours.assign(colours.begin(), colours.end());
+  data->sizes.assign(sizes.begin(), sizes.end());
+  data->default_colour = default_colour;
+  data->default_size = default_size;
+  
+  id set_id = Manager::get_next_gobj_id();
+  Thread_Message msg = { Thread_Message::add_point_set, std::make_tuple(win_id, set_id, std::shared_ptr< const Point_Data >(data)) };
+  Manager::push_msg_from_API(msg);
+  
+  return set_id;
 }
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Wrapper private
-////////////////////////////////////////////////////////////////////////////////
-
-void Window::Wrapper::create_glfw_window(){
-  window = glfwCreateWindow(640, 480, window_name.c_str(), NULL, NULL);
-  if( ! window)
-    throw std::runtime_error("GLFW window creation failed!");
-    
-  glfwMakeContextCurrent(window);
-  load_gl_functions();
+//------------------------------------------------------------------------------
+void Window::update_points(id win_id, id set_id, std::size_t first, std::span< const glm::vec2 > positions, std::span< const glm::vec3 > colours, std::span< const float > sizes){
+  auto data = std::make_shared< Point_Data >();
+  data->first = first;
+  data->positions.assign(positions.begin(), positions.end());
+  data->colours.assign(colours.begin(), colours.end());
+  data->sizes.assign(sizes.begin(), sizes.end());
   
-  glfwSetWindowUserPointer(window, (void*)w_id);   // try storing window_id as "pointer" (hacky!!!)
-  glfwSetErrorCallback(glfw_error);
-  glfwSetScrollCallback(window, scroll_callback);
+  Thread_Message msg = { Thread_Message::update_points, std::make_tuple(win_id, set_id, std::shared_ptr< const Point_Data >(data)) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::load_gl_functions(){
-  GLenum err = glewInit();   // needs to be called after every context creation!
-  if(err != GLEW_OK){
-    std::string message = "glewInit() returned: '";
-    message += reinterpret_cast<const char*>( glewGetErrorString(err) );   // fix incompatible "string" types
-    message += "'\n";
-    throw std::runtime_error("GLEW initialization failed! " + message);
-  }
+void Window::set_gobj_static(id win_id, id gobj_id, bool b){
+  Thread_Message msg = { Thread_Message::set_gobj_static, std::make_tuple(win_id, gobj_id, b) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::enable_gl_debugging(){
-  int flags;
-  glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
-  if(flags & GL_CONTEXT_FLAG_DEBUG_BIT){   // check if debug flag was set -> configure debugging
-    glEnable(GL_DEBUG_OUTPUT);
-    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-    ///glDebugMessageCallback(glDebugOutput, nullptr);   // function defined below
-    ///glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
-  }
+void Window::set_auto_static(id win_id, std::size_t frames){
+  Thread_Message msg = { Thread_Message::set_auto_static, std::make_tuple(win_id, frames) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::setup_shader_program(){
-  ///std::vector<std::string> shader_sources = {"src/shaders/simple_2d.frag", "src/shaders/simple_2d.vert"};
-  this->shader_program = std::make_shared<Shader_Program>();
+void Window::set_gobj_layer(id win_id, id gobj_id, int layer){
+  Thread_Message msg = { Thread_Message::set_gobj_layer, std::make_tuple(win_id, gobj_id, layer) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::exe_update(){
-  glfwMakeContextCurrent(window);
-  render();
+id Window::add_image(id win_id, std::size_t width, std::size_t height, std::span< const std::uint8_t > rgba){
+  if(width == 0 || height == 0 || width > Texture_Atlas::max_image_size || height > Texture_Atlas::max_image_size)
+    throw std::runtime_error("add_image(): Invalid image size!");
+  if(rgba.size() != width * height * 4)
+    throw std::runtime_error("add_image(): Pixel data has to contain width * height * 4 bytes!");
+  
+  auto image = std::make_shared< Image_Data >();
+  image->width = width;
+  image->height = height;
+  image->pixels.assign(rgba.begin(), rgba.end());
+  
+  id image_id = Manager::get_next_gobj_id();
+  Thread_Message msg = { Thread_Message::add_image, std::make_tuple(win_id, image_id, std::shared_ptr< const Image_Data >(image)) };
+  Manager::push_msg_from_API(msg);
+  
+  return image_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::render(){
-  // adjust window size
-  glfwGetFramebufferSize(window, &width, &height);
-  glViewport(0, 0, width, height);
+id Window::add_sprite(id win_id, id image_id, glm::vec3 position, float rotation, float size){
+  Sprite_Descriptor desc = {image_id, position, rotation, size};
   
-  // clear screen
-  set_background();
-  
-  // render content
-  shader_program->use();
-  camera.update(shader_program, (float)width, (float)height);
-  render_gobjects();
+  id sprite_id = Manager::get_next_gobj_id();
+  Thread_Message msg = { Thread_Message::add_sprite, std::make_tuple(win_id, sprite_id, desc) };
+  Manager::push_msg_from_API(msg);
   
-  // show content
-  glfwSwapBuffers(window);
+  return sprite_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::set_background(){
-  glClearColor(
-    background_colour.x,
-    background_colour.y,
-    background_colour.z,
-    1.0f
-  );
-  glClear(GL_COLOR_BUFFER_BIT);
+id Window::add_text(id win_id, const std::string& text, glm::vec3 position, float size, glm::vec3 colour){
+  Text_Descriptor desc = {text, position, size, colour};
+  
+  id text_id = Manager::get_next_gobj_id();
+  Thread_Message msg = { Thread_Message::add_text, std::make_tuple(win_id, text_id, std::move(desc)) };
+  Manager::push_msg_from_API(msg);
+  
+  return text_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Wrapper::render_gobjects(){
-  for(auto &obj : graphics_objects)
-    obj.second->render(shader_program);
+void Window::set_text(id win_id, id text_id, const std::string& text){
+  Thread_Message msg = { Thread_Message::set_text, std::make_tuple(win_id, text_id, text) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Manager public
-////////////////////////////////////////////////////////////////////////////////
-
-Window::Manager& Window::Manager::get_instance(){
-  static Manager instance;   // the single instance
-  return instance;
+//------------------------------------------------------------------------------
+void Window::animate_position(id win_id, id gobj_id, glm::vec3 target, float duration, easing ease){
+  push_tween(win_id, gobj_id, {tw_position, target, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-bool Window::Manager::win_got_closed(id id){
-  return got_closed.at(id);
+void Window::animate_rotation(id win_id, id gobj_id, float target, float duration, easing ease){
+  push_tween(win_id, gobj_id, {tw_rotation, {target, 0.0f, 0.0f}, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-std::size_t Window::Manager::get_count(){
-  return window_count;
+void Window::animate_scale(id win_id, id gobj_id, float target, float duration, easing ease){
+  push_tween(win_id, gobj_id, {tw_scale, {target, 0.0f, 0.0f}, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::push_msg_from_API(const Thread_Message& msg){
-  std::lock_guard lock(get_instance().messages_from_API.mutex);
-  get_instance().messages_from_API.data.push( msg );
+void Window::animate_colour(id win_id, id gobj_id, glm::vec3 target, float duration, easing ease){
+  push_tween(win_id, gobj_id, {tw_colour, target, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::process_msgs_to_API(){
-  while(true){
-    Thread_Message msg;
-    
-    {
-      std::lock_guard lock(get_instance().messages_to_API.mutex);
-      if(get_instance().messages_to_API.data.empty())
-        break;
-      
-      else{
-        msg = get_instance().messages_to_API.data.front();
-        get_instance().messages_to_API.data.pop();
-      }
-    }
-    
-    get_instance().process_msg(msg);
-  }
+void Window::animate_camera_position(id win_id, glm::vec3 target, float duration, easing ease){
+  push_tween(win_id, 0, {tw_camera_position, target, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-id Window::Manager::get_next_win_id(){
-  get_instance().next_win_id++;
-  get_instance().got_closed.insert( {get_instance().next_win_id, false} );
+void Window::animate_camera_zoom(id win_id, float target, float duration, easing ease){
+  if(target <= 0.0f)
+    throw std::runtime_error("animate_camera_zoom(): Zoom has to be positive!");
   
-  return get_instance().next_win_id;
+  push_tween(win_id, 0, {tw_camera_zoom, {target, 0.0f, 0.0f}, duration, ease});
 }
 
 
 
 //------------------------------------------------------------------------------
-id Window::Manager::get_next_gobj_id(){
-  return get_instance().next_gobj_id++;
+void Window::set_gobj_velocity(id win_id, id gobj_id, glm::vec2 velocity){
+  Thread_Message msg = { Thread_Message::set_gobj_velocity, std::make_tuple(win_id, gobj_id, velocity) };
+  Manager::push_msg_from_API(msg);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-// Manager private
-////////////////////////////////////////////////////////////////////////////////
 
-Window::Manager::Manager(){
-  init_glfw();
-  graphics_thread = std::thread(&Window::Manager::thread_func, this);
+
+//------------------------------------------------------------------------------
+void Window::set_gobj_acceleration(id win_id, id gobj_id, glm::vec2 acceleration){
+  Thread_Message msg = { Thread_Message::set_gobj_acceleration, std::make_tuple(win_id, gobj_id, acceleration) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-Window::Manager::~Manager(){
-  stop_thread.store(true);
-  graphics_thread.join();
-  
-  windows.clear();
-  
-  glfwTerminate();
+void Window::set_gobj_angular_velocity(id win_id, id gobj_id, float angular_velocity){
+  Thread_Message msg = { Thread_Message::set_gobj_angular_velocity, std::make_tuple(win_id, gobj_id, angular_velocity) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::init_glfw(){
-  if( ! glfwInit())
-    throw std::runtime_error("GLFW initialization failed!");
+id Window::add_group(id win_id, glm::vec3 position, float rotation){
+  id group_id = Manager::get_next_gobj_id();
   
-  // use OpenGL version 3.3 core  
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  Thread_Message msg = { Thread_Message::add_group, std::make_tuple(win_id, group_id, position, rotation) };
+  Manager::push_msg_from_API(msg);
   
-  // enable GLFW debugging
-  glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);   // remove in "release"!
+  return group_id;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::thread_func(){
-  try{  thread_loop();  }
+void Window::set_gobj_parent(id win_id, id gobj_id, id parent_id){
+  Thread_Message msg = { Thread_Message::set_gobj_parent, std::make_tuple(win_id, gobj_id, parent_id) };
+  Manager::push_msg_from_API(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::remove_gobj_parent(id win_id, id gobj_id){
+  Thread_Message msg = { Thread_Message::remove_gobj_parent, std::make_tuple(win_id, gobj_id) };
+  Manager::push_msg_from_API(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr< Shared_Scene > Window::share_scene(id win_id, std::span< const id > gobj_ids){
+  auto scene = std::make_shared< Shared_Scene >( std::vector< std::uint64_t >(gobj_ids.begin(), gobj_ids.end()) );
   
-  catch(std::exception& e){
-    std::string message = "Window::Manager: ";
-    message += e.what();
-    throw std::runtime_error( message );
-  }
+  Thread_Message msg = { Thread_Message::share_scene, std::make_tuple(win_id, scene) };
+  Manager::push_msg_from_API(msg);
+  
+  return scene;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::thread_loop(){
-  while( ! stop_thread.load() ){
-    glfwPollEvents();
-    process_msgs_from_API();
-    update_windows();
-    wait_until_next_frame();
-  }
+void Window::unshare_scene(id win_id){
+  Thread_Message msg = { Thread_Message::share_scene, std::make_tuple(win_id, std::shared_ptr< Shared_Scene >()) };
+  Manager::push_msg_from_API(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::update_windows(){
-  for(auto &w : windows)
-    w.second->update();
+std::future< std::optional< id > > Window::pick(id win_id, int x, int y){
+  auto request = std::make_shared< Pick_Request >();
+  request->x = x;
+  request->y = y;
+  request->width = 1;
+  request->height = 1;
+  request->result = std::promise< std::optional< id > >();
+  auto result = std::get< std::promise< std::optional< id > > >(request->result).get_future();
+  
+  Thread_Message msg = { Thread_Message::pick, std::make_tuple(win_id, request) };
+  Manager::push_msg_from_API(msg);
+  
+  return result;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::wait_until_next_frame(){
-  using namespace std::chrono;
-  using namespace std::chrono_literals;
+std::future< std::vector< id > > Window::pick_rect(id win_id, int x, int y, int width, int height){
+  if(width <= 0  ||  height <= 0)
+    throw std::runtime_error("pick_rect(): Width and height have to be positive!");
   
-  steady_clock::time_point now = steady_clock::now();
-  microsecs time_elapsed = duration_cast<microseconds>(now - prev_time).count();
-  prev_time = now;
+  auto request = std::make_shared< Pick_Request >();
+  request->x = x;
+  request->y = y;
+  request->width = width;
+  request->height = height;
+  request->result = std::promise< std::vector< id > >();
+  auto result = std::get< std::promise< std::vector< id > > >(request->result).get_future();
   
-  microsecs time_per_frame = 1000000 / fps;
-  microsecs wait_time = 0;
-  if(time_per_frame > time_elapsed)
-    wait_time = time_per_frame - time_elapsed;
+  Thread_Message msg = { Thread_Message::pick, std::make_tuple(win_id, request) };
+  Manager::push_msg_from_API(msg);
   
-  std::this_thread::sleep_for( microseconds(wait_time) );
+  return result;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::push_msg_to_API(const Thread_Message& msg){
-  std::lock_guard lock(messages_to_API.mutex);
-  messages_to_API.data.push( msg );
+std::future< void > Window::export_image(id win_id, const std::string& path, std::size_t width, std::size_t height){
+  if(width == 0  ||  height == 0)
+    throw std::runtime_error("export_image(): Width and height have to be positive!");
+  
+  auto request = std::make_shared< Export_Request >();
+  request->path = path;
+  request->width = width;
+  request->height = height;
+  auto result = request->done.get_future();
+  
+  Thread_Message msg = { Thread_Message::export_image, std::make_tuple(win_id, request) };
+  Manager::push_msg_from_API(msg);
+  
+  return result;
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::process_msgs_from_API(){
-  while(true){
-    Thread_Message msg;
-    
-    {
-      std::lock_guard lock(messages_from_API.mutex);
-      if(messages_from_API.data.empty())
-        break;
-      
-      else{
-        msg = messages_from_API.data.front();
-        messages_from_API.data.pop();
-      }
-    }
-    
-    process_msg(msg);
-  }
+std::future< void > Window::save_snapshot(id win_id, const std::string& path){
+  auto request = std::make_shared< Snapshot_Request >();
+  request->path = path;
+  auto result = request->done.get_future();
+  
+  Thread_Message msg = { Thread_Message::save_snapshot, std::make_tuple(win_id, request) };
+  Manager::push_msg_from_API(msg);
+  
+  return result;
+}
+
+
+
+//------------------------------------------------------------------------------
+std::future< Image_Data > Window::capture(id win_id){
+  auto request = std::make_shared< Capture_Request >();
+  auto result = request->result.get_future();
+  
+  Thread_Message msg = { Thread_Message::capture, std::make_tuple(win_id, request) };
+  Manager::push_msg_from_API(msg);
+  
+  return result;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::load_snapshot(id win_id, const std::string& path){
+  auto snapshot = std::make_shared< Scene_Snapshot >(path);   // mapped & validated here, uploaded by graphics thread
+  
+  Thread_Message msg = { Thread_Message::load_snapshot, std::make_tuple(win_id, snapshot) };
+  Manager::push_msg_from_API(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+Render_Stats Window::get_render_stats(id win_id){
+  return Manager::get_instance().get_render_stats(win_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::set_queue_capacity(std::size_t capacity, queue_policy policy){
+  Manager::get_instance().set_queue_capacity(capacity, policy);
+}
+
+
+
+//------------------------------------------------------------------------------
+Queue_Stats Window::get_queue_stats(){
+  return Manager::get_instance().get_queue_stats();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::set_command_buffering(std::size_t chunk_size){
+  flush_commands();
+  Manager::get_command_buffer().chunk_size = chunk_size;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::flush_commands(){
+  auto& buffer = Manager::get_command_buffer();
+  if( !buffer.msgs.empty() )
+    Manager::get_instance().push_msgs_from_API(buffer.msgs);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::start_recording(const std::string& path){
+  Manager::get_instance().start_recording(path);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::stop_recording(){
+  flush_commands();   // messages still buffered by this thread belong to the recording
+  Manager::get_instance().stop_recording();
+}
+
+
+
+//------------------------------------------------------------------------------
+Replay_Stats Window::replay(const std::string& path, replay_timing timing){
+  using namespace std::chrono;
+  
+  Command_Replayer replayer(path);
+  Thread_Message msg;
+  nanoseconds delay;
+  Replay_Stats stats;
+  
+  steady_clock::time_point start = steady_clock::now();
+  steady_clock::time_point due = start;
+  while( replayer.next(msg, delay) ){
+    if(timing == r_original){
+      due += delay;
+      std::this_thread::sleep_until(due);
+    }
+    
+    Manager::reserve_ids(msg);   // ids used as recorded -> open()/add_*() continue after them
+    Manager::push_msg_from_API(msg);
+    stats.messages++;
+  }
+  flush_commands();
+  
+  stats.seconds = duration<double>(steady_clock::now() - start).count();
+  return stats;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::set_headless(bool b){
+  Manager::get_instance().set_headless(b);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Window private
+////////////////////////////////////////////////////////////////////////////////
+
+void Window::push_tween(id win_id, id gobj_id, const Tween_Descriptor& desc){
+  if(desc.duration < 0.0f)
+    throw std::runtime_error("animate(): Duration must not be negative!");
+  
+  Thread_Message msg = { Thread_Message::animate, std::make_tuple(win_id, gobj_id, desc) };
+  Manager::push_msg_from_API(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+Window::Command_Buffer::~Command_Buffer(){
+  if(msgs.empty())
+    return;
+  
+  try{
+    Manager::get_instance().push_msgs_from_API(msgs);
+  }
+  catch(...){
+    // thread is exiting; nobody left to report to
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Wrapper public
+////////////////////////////////////////////////////////////////////////////////
+
+Window::Wrapper::Wrapper(id w_id, render_backend backend)
+  : jobs( Manager::get_instance().get_jobs() ){
+  
+  this->w_id = w_id;
+  this->backend = backend;
+  
+  if(backend == rb_software){
+    rasterizer = std::make_unique< Soft_Rasterizer >(jobs);
+    width = 640;   // same as a new GLFW window
+    height = 480;
+    return;
+  }
+  
+  create_glfw_window();
+  enable_gl_debugging();
+  setup_render_context();
+}
+
+
+
+//------------------------------------------------------------------------------
+Window::Wrapper::~Wrapper(){
+  stop_render.store(true);   // normally already stopped by the Manager (waiting messages are dropped here)
+  if(render_thread.joinable())
+    render_thread.join();
+  
+  if( ! window)   // software window: nothing on the GPU
+    return;
+  
+  // GL objects have to be deleted while their context still exists
+  glfwMakeContextCurrent(window);
+  graphics_objects.clear();
+  static_batch.clear();
+  snapshot_layer.clear();
+  shape_batch.clear();
+  sprite_batch.clear();
+  picker.clear();
+  atlas.clear();
+  meshes.clear();
+  render_context.reset();
+  
+  glfwDestroyWindow(window);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::update(float delta_time){
+  if( window  &&  glfwWindowShouldClose(window) ){
+    Thread_Message msg = { Thread_Message::close_win, w_id };
+    Manager::get_instance().push_msg_internal(msg);
+  }
+    
+  else if(on_render_thread)
+    sync_window_size();   // frame itself is rendered by the render thread
+  
+  else
+    exe_update(delta_time);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::update_name(const std::string& name){
+  window_name = name;
+  if(window)
+    glfwSetWindowTitle(window, name.c_str());
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr< GShape > Window::Wrapper::new_gobject(const GObject_Descriptor& desc){
+  return std::make_shared< GShape >(desc.position, desc.rotation, desc.size, desc.colour, get_unit_mesh(desc.type));
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::add_gobject(id gobj_id, std::shared_ptr< GObject > obj){
+  graphics_objects.insert( {gobj_id, obj} );
+  render_queue.invalidate();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr< GObject > Window::Wrapper::get_gobject(id gobj_id){
+  auto obj = graphics_objects.find(gobj_id);
+  if(obj != graphics_objects.end())
+    return obj->second;
+  
+  auto baked = static_batch.get(gobj_id);
+  if(baked)
+    return baked;
+  
+  auto group = groups.find(gobj_id);
+  if(group == groups.end())
+    throw std::out_of_range("Window::Wrapper: Unknown graphics_object!");
+  
+  return group->second;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::gobject_changed(id gobj_id){
+  if(static_batch.is_pinned(gobj_id)){
+    static_batch.touch(gobj_id);   // stays baked -> re-bake its chunk
+    return;
+  }
+  
+  auto baked = static_batch.remove(gobj_id);   // automatically baked -> dynamic again
+  if(baked){
+    graphics_objects.insert( {gobj_id, baked} );
+    render_queue.invalidate();
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::remove_gobject(id gobj_id){
+  graphics_objects.erase(gobj_id);
+  static_batch.remove(gobj_id);
+  tweens.remove_target(gobj_id);
+  kinematics.remove(gobj_id);
+  hierarchy.remove(gobj_id);
+  groups.erase(gobj_id);
+  if(shared_scene){
+    const auto& ids = shared_scene->get_ids();
+    for(std::size_t i = 0; i < ids.size(); i++)
+      if(ids[i] == gobj_id)
+        shared_objs[i] = nullptr;
+  }
+  render_queue.invalidate();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::clear_gobjects(){
+  graphics_objects.clear();
+  static_batch.clear();
+  snapshot_layer.clear();
+  tweens.clear_targets();
+  kinematics.clear();
+  hierarchy.clear();
+  groups.clear();
+  for(auto& obj : shared_objs)
+    obj = nullptr;
+  render_queue.invalidate();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::set_gobj_static(id gobj_id, bool b){
+  if( ! b){
+    auto baked = static_batch.remove(gobj_id);
+    if(baked){
+      baked->unmoved_frames = 0;
+      graphics_objects.insert( {gobj_id, baked} );
+      render_queue.invalidate();
+    }
+    return;
+  }
+  
+  auto obj = graphics_objects.find(gobj_id);
+  if(obj == graphics_objects.end()){   // already baked -> pin
+    auto baked = static_batch.get(gobj_id);
+    if(baked)
+      static_batch.add(gobj_id, baked, true);
+    return;
+  }
+  
+  auto shape = std::dynamic_pointer_cast< GShape >(obj->second);
+  if( ! shape)   // only GShapes can be baked
+    return;
+  
+  static_batch.add(gobj_id, shape, true);
+  graphics_objects.erase(obj);
+  render_queue.invalidate();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::start_render_thread(){
+  if(on_render_thread)
+    return;
+  
+  if(window){
+    sync_window_size();
+    if(glfwGetCurrentContext() == window)
+      glfwMakeContextCurrent(nullptr);   // a context can only be current on one thread
+  }
+  
+  on_render_thread = true;
+  stop_render.store(false);
+  render_thread = std::thread(&Wrapper::render_loop, this);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::stop_render_thread(){
+  if( !on_render_thread )
+    return;
+  
+  stop_render.store(true);
+  render_thread.join();   // releases the context on exit
+  on_render_thread = false;
+  
+  if(window)
+    glfwMakeContextCurrent(window);
+  apply_inbox();   // posted after the last frame of the render thread
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Wrapper::has_render_thread(){
+  return on_render_thread;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::post(const Thread_Message& msg){
+  std::lock_guard lock(inbox_mutex);
+  msg_inbox.push_back(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::post(const Input_Event& event){
+  std::lock_guard lock(inbox_mutex);
+  input_inbox.push_back(event);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Wrapper private
+////////////////////////////////////////////////////////////////////////////////
+
+void Window::Wrapper::create_glfw_window(){
+  glfwWindowHint( GLFW_VISIBLE, Manager::get_instance().is_headless() ? GLFW_FALSE : GLFW_TRUE );   // hidden windows still render
+  window = glfwCreateWindow(640, 480, window_name.c_str(), NULL, NULL);
+  if( ! window)
+    throw std::runtime_error("GLFW window creation failed!");
+    
+  glfwMakeContextCurrent(window);
+  load_gl_functions();
+  
+  glfwSetWindowUserPointer(window, (void*)w_id);   // try storing window_id as "pointer" (hacky!!!)
+  glfwSetErrorCallback(glfw_error);
+  glfwSetScrollCallback(window, scroll_callback);
+  glfwSetKeyCallback(window, key_callback);
+  glfwSetMouseButtonCallback(window, mouse_button_callback);
+  glfwSetCursorPosCallback(window, cursor_callback);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::animate(id gobj_id, const Tween_Descriptor& desc){
+  // animation starts at current value
+  glm::vec3 start;
+  switch(desc.property){
+  case tw_camera_position: start = camera.get_position();   break;
+  case tw_camera_zoom:     start = glm::vec3(camera.get_zoom(), 0.0f, 0.0f);   break;
+  case tw_position:        start = get_gobject(gobj_id)->get_position();   break;
+  case tw_rotation:        start = glm::vec3(get_gobject(gobj_id)->get_rotation(), 0.0f, 0.0f);   break;
+  case tw_scale:           start = glm::vec3(get_gobject(gobj_id)->get_size(), 0.0f, 0.0f);   break;
+  case tw_colour:          start = get_gobject(gobj_id)->get_colour();   break;
+  default:                 throw std::runtime_error("Window::Wrapper: Invalid tween property!");
+  }
+  
+  tweens.add(gobj_id, desc.property, start, desc.target, desc.duration, desc.ease);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::add_group(id group_id, std::shared_ptr< GGroup > group){
+  groups.insert( {group_id, group} );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::set_gobj_parent(id gobj_id, id parent_id){
+  auto obj = get_gobject(gobj_id);
+  auto parent = get_gobject(parent_id);
+  
+  if(hierarchy.set_parent(gobj_id, obj, parent_id, parent))   // ignored if it would create a cycle
+    gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::handle_input(const Input_Event& event){
+  glm::vec2 scale = get_pixel_scale();
+  
+  switch(event.type){
+  case in_scroll:{
+    if( !allow_zoom )
+      break;
+    glm::vec2 pos = cursor;   // glfwGetCursorPos() is main thread only
+    if( !on_render_thread ){
+      double x, y;
+      glfwGetCursorPos(window, &x, &y);
+      pos = glm::vec2(x, y);
+    }
+    navigation.zoom(camera, pos * scale, event.value.y, glm::vec2(width, height));
+    break;
+  }
+  case in_mouse_button:{
+    if(event.code != GLFW_MOUSE_BUTTON_LEFT)
+      break;
+    if(event.action == GLFW_PRESS  &&  allow_camera_movement)
+      navigation.begin_drag(event.value * scale, event.time);
+    else if(event.action == GLFW_RELEASE)
+      navigation.end_drag(event.time);
+    break;
+  }
+  case in_cursor:{
+    cursor = event.value;
+    navigation.drag(camera, event.value * scale, event.time);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::pick(std::shared_ptr< Pick_Request > request){
+  if(backend == rb_software){
+    std::visit( [](auto& result){
+      result.set_exception( std::make_exception_ptr(std::runtime_error("pick(): Not supported by software windows!")) );
+    }, request->result );
+    return;
+  }
+  
+  glm::vec2 scale = get_pixel_scale();
+  int x1 = (int)((request->x + request->width) * scale.x);
+  int y1 = (int)((request->y + request->height) * scale.y);
+  request->x = (int)(request->x * scale.x);
+  request->y = (int)(request->y * scale.y);
+  request->width = std::max(x1 - request->x, 1);
+  request->height = std::max(y1 - request->y, 1);
+  
+  picker.add(request);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::export_image(std::shared_ptr< Export_Request > request){
+  if(backend == rb_software){
+    request->done.set_exception( std::make_exception_ptr(std::runtime_error("export_image(): Not supported by software windows!")) );
+    return;
+  }
+  
+  exports.push_back(request);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::capture(std::shared_ptr< Capture_Request > request){
+  captures.push_back(request);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::save_snapshot(std::shared_ptr< Snapshot_Request > request){
+  try{
+    std::array< std::vector< Snapshot_Object >, 3 > objects;   // per gobj_type
+    
+    auto add_shape = [&](GShape& shape){
+      auto type = get_gobj_type(shape);
+      if( type.has_value() )   // else: not created through add_gobject()
+        objects[type.value()].push_back( {shape.get_world_position(), shape.get_world_rotation(), shape.get_size(), shape.get_colour()} );
+    };
+    
+    for(int t = t_triangle; t <= t_circle; t++){
+      auto restored = snapshot_layer.get_objects( (gobj_type)t );
+      objects[t].assign(restored.begin(), restored.end());
+    }
+    static_batch.for_each( [&](id, GShape& shape){  add_shape(shape);  } );
+    for(auto &obj : graphics_objects)
+      if(obj.second->get_batch_type() == b_shape)
+        add_shape( static_cast< GShape& >(*obj.second) );
+    
+    Scene_Snapshot::write(request->path, camera.get_position(), camera.get_zoom(), background_colour, objects);
+    request->done.set_value();
+  }
+  catch(std::exception& e){
+    request->done.set_exception( std::current_exception() );
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::load_snapshot(std::shared_ptr< Scene_Snapshot > snapshot){
+  clear_gobjects();
+  snapshot_layer.set(snapshot);
+  
+  const auto& header = snapshot->get_header();
+  navigation.stop();
+  camera.set_position(header.camera_position);
+  camera.set_zoom(header.camera_zoom);
+  background_colour = header.background_colour;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::share_scene(std::shared_ptr< Shared_Scene > scene){
+  shared_objs.clear();
+  shared_scene = scene;
+  if( !shared_scene )
+    return;
+  
+  for(auto gobj_id : shared_scene->get_ids())
+    shared_objs.push_back( get_gobject(gobj_id) );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::load_gl_functions(){
+  GLenum err = glewInit();   // needs to be called after every context creation!
+  if(err != GLEW_OK){
+    std::string message = "glewInit() returned: '";
+    message += reinterpret_cast<const char*>( glewGetErrorString(err) );   // fix incompatible "string" types
+    message += "'\n";
+    throw std::runtime_error("GLEW initialization failed! " + message);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::enable_gl_debugging(){
+  int flags;
+  glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+  if(flags & GL_CONTEXT_FLAG_DEBUG_BIT){   // check if debug flag was set -> configure debugging
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    ///glDebugMessageCallback(glDebugOutput, nullptr);   // function defined below
+    ///glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::setup_render_context(){
+  ///std::vector<std::string> shader_sources = {"src/shaders/simple_2d.frag", "src/shaders/simple_2d.vert"};
+  this->render_context = std::make_shared<Render_Context>();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::exe_update(float delta_time){
+  if(window  &&  !on_render_thread)   // render thread keeps its context current
+    glfwMakeContextCurrent(window);
+  navigation.update(camera, delta_time);
+  move_gobjects(delta_time);
+  apply_shared_scene();
+  apply_tweens(delta_time);
+  update_transforms();
+  bake_unmoved_gobjects();
+  if(backend == rb_software)
+    render_software();
+  else
+    render();
+  if( !exports.empty() )
+    run_exports();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::move_gobjects(float delta_time){
+  const auto& moving = kinematics.get_ids();
+  if(moving.empty())
+    return;
+  
+  kinematics.integrate(delta_time, jobs);
+  
+  if(static_batch.size() == 0)   // nothing can be baked
+    return;
+  for(auto gobj_id : moving)
+    gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::apply_shared_scene(){
+  if( !shared_scene  ||  !shared_scene->acquire() )
+    return;
+  
+  // read straight from the published buffer; no lock, no copy of the arrays
+  auto positions = shared_scene->front_positions();
+  auto rotations = shared_scene->front_rotations();
+  auto colours = shared_scene->front_colours();
+  const auto& ids = shared_scene->get_ids();
+  bool bakeable = static_batch.size() > 0;
+  
+  for(std::size_t i = 0; i < shared_objs.size(); i++){
+    auto& obj = shared_objs[i];
+    if( !obj )
+      continue;
+    
+    obj->set_position(positions[i]);
+    obj->set_rotation(rotations[i]);
+    obj->set_colour(colours[i]);
+    if(bakeable)
+      gobject_changed(ids[i]);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::apply_tweens(float delta_time){
+  if(tweens.size() == 0)
+    return;
+  
+  tweens.update(delta_time);   // one pass over all tweens
+  
+  for(std::size_t i = 0; i < tweens.size(); i++){
+    glm::vec3 value = tweens.get_value(i);
+    tween_property property = tweens.get_property(i);
+    
+    if(property == tw_camera_position){
+      camera.set_position(value);
+      continue;
+    }
+    if(property == tw_camera_zoom){
+      camera.set_zoom(value.x);
+      continue;
+    }
+    
+    id gobj_id = tweens.get_target(i);
+    auto obj = get_gobject(gobj_id);
+    switch(property){
+    case tw_position: obj->set_position(value);   break;
+    case tw_rotation: obj->set_rotation(value.x);   break;
+    case tw_scale:    obj->set_size(value.x);   break;
+    case tw_colour:   obj->set_colour(value);   break;
+    default:          break;
+    }
+    gobject_changed(gobj_id);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::update_transforms(){
+  hierarchy.update();
+  
+  if(static_batch.size() == 0)   // nothing can be baked
+    return;
+  for(auto gobj_id : hierarchy.get_changed())
+    gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::bake_unmoved_gobjects(){
+  if(auto_static_frames == 0)
+    return;
+  
+  for(auto obj = graphics_objects.begin(); obj != graphics_objects.end(); ){
+    auto shape = std::dynamic_pointer_cast< GShape >(obj->second);
+    
+    if(shape && ++shape->unmoved_frames >= auto_static_frames){
+      static_batch.add(obj->first, shape, false);
+      obj = graphics_objects.erase(obj);
+      render_queue.invalidate();
+    }
+    else
+      obj++;
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::render(){
+  auto start = std::chrono::steady_clock::now();
+  
+  // adjust window size
+  if(on_render_thread){
+    width = fb_width.load(std::memory_order_relaxed);
+    height = fb_height.load(std::memory_order_relaxed);
+  }
+  else
+    glfwGetFramebufferSize(window, &width, &height);
+  glViewport(0, 0, width, height);
+  
+  // clear screen
+  set_background();
+  
+  // render content
+  render_context->begin_frame(camera, (float)width, (float)height);
+  picker.collect();   // readbacks of previous frames
+  render_gobjects();
+  if( picker.waiting() )
+    render_pick_pass();
+  fulfil_captures();
+  
+  Render_Stats stats = render_context->get_stats();
+  stats.render_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();   // without waiting for vsync
+  
+  // show content
+  glfwSwapBuffers(window);
+  
+  stats.atlas_pages = atlas.page_count();
+  stats.atlas_occupancy = atlas.occupancy();
+  Manager::get_instance().publish_render_stats(w_id, stats);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::render_software(){
+  auto start = std::chrono::steady_clock::now();
+  
+  rasterizer->begin_frame(width, height, background_colour);
+  glm::mat4 view_projection = camera.get_projection((float)width, (float)height) * camera.get_view((float)width, (float)height);
+  
+  auto add_shape = [&](GShape& shape){
+    auto& mesh = shape.get_mesh();
+    rasterizer->add(mesh->get_vertices(), mesh->get_indices(), view_projection * shape.get_model_matrix(), shape.get_colour());
+  };
+  
+  // same order as render_gobjects(): restored snapshot, then the render queue with each baked layer before its dynamic objects
+  for(int t = t_triangle; t <= t_circle; t++){
+    auto mesh = get_unit_mesh( (gobj_type)t );
+    for(const auto &obj : snapshot_layer.get_objects( (gobj_type)t )){
+      glm::mat4 model = glm::translate(glm::mat4(1.0f), obj.position);
+      model = glm::rotate(model, glm::radians(obj.rotation), glm::vec3(0.0f, 0.0f, 1.0f));   // z-axis
+      model = glm::scale(model, glm::vec3(obj.size, obj.size, 1.0f));
+      rasterizer->add(mesh->get_vertices(), mesh->get_indices(), view_projection * model, obj.colour);
+    }
+  }
+  
+  // sprites, text, polylines & point sets are GL only
+  static_batch.get_layers(baked_layers);
+  std::size_t next_baked = 0;
+  auto add_baked = [&](int layer){
+    while(next_baked < baked_layers.size()  &&  baked_layers[next_baked] <= layer)
+      static_batch.for_each( baked_layers[next_baked++], [&](id, GShape& shape){  add_shape(shape);  } );
+  };
+  
+  const auto& queue = render_queue.sort(graphics_objects, jobs);
+  for(const auto &item : queue){
+    add_baked( item.obj->get_layer() );
+    if(item.obj->get_batch_type() == b_shape)
+      add_shape( static_cast< GShape& >(*item.obj) );
+  }
+  add_baked( std::numeric_limits< int >::max() );
+  
+  rasterizer->end_frame();
+  fulfil_captures();
+  
+  Render_Stats stats;
+  stats.objects = queue.size();
+  stats.render_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+  Manager::get_instance().publish_render_stats(w_id, stats);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::fulfil_captures(){
+  if(captures.empty())
+    return;
+  
+  Image_Data image;
+  image.width = width;
+  image.height = height;
+  
+  if(backend == rb_software)
+    rasterizer->read_pixels(image.pixels);
+  
+  else{   // back buffer; GL rows start at the bottom
+    image.pixels.resize( (std::size_t)width * height * 4 );
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+    
+    std::size_t row_bytes = (std::size_t)width * 4;
+    for(int y = 0; y < height / 2; y++)
+      std::swap_ranges(
+        image.pixels.begin() + y * row_bytes,
+        image.pixels.begin() + (y + 1) * row_bytes,
+        image.pixels.begin() + (height - 1 - y) * row_bytes
+      );
+  }
+  
+  for(auto &request : captures)
+    request->result.set_value(image);
+  captures.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::set_background(){
+  glClearColor(
+    background_colour.x,
+    background_colour.y,
+    background_colour.z,
+    1.0f
+  );
+  glClear(GL_COLOR_BUFFER_BIT);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::render_gobjects(){
+  atlas.upload(*render_context);
+  snapshot_layer.render(*render_context);   // restored snapshot (background)
+  
+  // baked shapes of a layer are drawn right before the dynamic objects of that layer
+  static_batch.get_layers(baked_layers);
+  std::size_t next_baked = 0;
+  auto baked_pending = [&](int layer){
+    return next_baked < baked_layers.size()  &&  baked_layers[next_baked] <= layer;
+  };
+  auto render_baked = [&](int layer){
+    if( !baked_pending(layer) )
+      return;
+    flush_batches();
+    while( baked_pending(layer) )
+      static_batch.render(*render_context, baked_layers[next_baked++]);
+  };
+  
+  // consecutive GShapes (any mesh) go out as one multi-draw, consecutive sprites/labels as one instanced draw
+  const auto& queue = render_queue.sort(graphics_objects, jobs);
+  for(std::size_t i = 0; i < queue.size(); i++){
+    const auto& item = queue[i];
+    render_baked( item.obj->get_layer() );
+    
+    switch( item.obj->get_batch_type() ){
+    case b_shape:
+      sprite_batch.flush(*render_context, atlas);
+      
+      // the whole run at once -> per-draw data can be filled in parallel (ends where baked shapes go in between)
+      shape_run.clear();
+      for( ; i < queue.size()  &&  queue[i].obj->get_batch_type() == b_shape  &&  !baked_pending( queue[i].obj->get_layer() ); i++)
+        shape_run.push_back( static_cast< GShape* >(queue[i].obj) );
+      i--;   // last shape of the run
+      
+      shape_batch.add(shape_run, jobs);
+      break;
+    case b_sprite:
+      shape_batch.flush(*render_context);
+      sprite_batch.add( static_cast< GSprite& >(*item.obj), atlas );
+      break;
+    case b_text:
+      shape_batch.flush(*render_context);
+      sprite_batch.add( static_cast< GText& >(*item.obj), atlas );
+      break;
+    default:
+      flush_batches();
+      item.obj->render(*render_context);
+    }
+  }
+  render_baked( std::numeric_limits< int >::max() );   // layers above all dynamic objects
+  flush_batches();
+  
+  render_context->count_objects(queue.size());
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::flush_batches(){
+  shape_batch.flush(*render_context);
+  sprite_batch.flush(*render_context, atlas);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::render_pick_pass(){
+  // same draw order as render_gobjects(), ids instead of colours;
+  // polylines & point sets can't be picked
+  picker.begin_pass(width, height);
+  
+  static_batch.get_layers(baked_layers);
+  std::size_t next_baked = 0;
+  auto add_baked = [&](int layer){
+    while(next_baked < baked_layers.size()  &&  baked_layers[next_baked] <= layer){
+      sprite_batch.flush(*render_context, atlas, p_sprite_pick);
+      static_batch.for_each(baked_layers[next_baked++], [&](id gobj_id, GShape& shape){
+        shape_batch.add( shape, Picker::encode(gobj_id) );
+      });
+    }
+  };
+  
+  for(const auto &item : render_queue.sort(graphics_objects, jobs)){
+    add_baked( item.obj->get_layer() );
+    
+    switch( item.obj->get_batch_type() ){
+    case b_shape:
+      sprite_batch.flush(*render_context, atlas, p_sprite_pick);
+      shape_batch.add( static_cast< GShape& >(*item.obj), Picker::encode(item.gobj_id) );
+      break;
+    case b_sprite:
+      shape_batch.flush(*render_context, p_shape_pick);
+      sprite_batch.add( static_cast< GSprite& >(*item.obj), atlas, Picker::encode(item.gobj_id) );
+      break;
+    case b_text:
+      shape_batch.flush(*render_context, p_shape_pick);
+      sprite_batch.add( static_cast< GText& >(*item.obj), atlas, Picker::encode(item.gobj_id) );
+      break;
+    default:
+      break;
+    }
+  }
+  add_baked( std::numeric_limits< int >::max() );
+  shape_batch.flush(*render_context, p_shape_pick);
+  sprite_batch.flush(*render_context, atlas, p_sprite_pick);
+  
+  picker.end_pass();
+}
+
+
+
+//------------------------------------------------------------------------------
+glm::vec2 Window::Wrapper::get_pixel_scale(){
+  int w, h;
+  if(on_render_thread){
+    w = win_width.load(std::memory_order_relaxed);
+    h = win_height.load(std::memory_order_relaxed);
+  }
+  else
+    glfwGetWindowSize(window, &w, &h);
+  
+  if(w <= 0  ||  h <= 0)
+    return {1.0f, 1.0f};
+  
+  return glm::vec2( (float)width / w, (float)height / h );
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::sync_window_size(){
+  if( ! window)
+    return;
+  
+  int w, h;
+  glfwGetFramebufferSize(window, &w, &h);
+  fb_width.store(w, std::memory_order_relaxed);
+  fb_height.store(h, std::memory_order_relaxed);
+  
+  glfwGetWindowSize(window, &w, &h);
+  win_width.store(w, std::memory_order_relaxed);
+  win_height.store(h, std::memory_order_relaxed);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::render_loop(){
+  using namespace std::chrono;
+  
+  if(window)
+    glfwMakeContextCurrent(window);   // once, not every frame
+  
+  steady_clock::time_point prev_frame_start = steady_clock::now();
+  steady_clock::time_point next_frame = prev_frame_start;
+  
+  try{
+    while( ! stop_render.load() ){
+      apply_inbox();
+      
+      steady_clock::time_point frame_start = steady_clock::now();
+      exe_update( duration<float>(frame_start - prev_frame_start).count() );
+      prev_frame_start = frame_start;
+      
+      // own frame rate, independent of the graphics thread & other windows
+      next_frame += microseconds(1000000 / render_fps);
+      if(next_frame < steady_clock::now())
+        next_frame = steady_clock::now();   // fell behind -> don't catch up
+      std::this_thread::sleep_until(next_frame);
+    }
+  }
+  
+  catch(std::exception& e){
+    std::string message = "Window::Wrapper: ";
+    message += e.what();
+    throw std::runtime_error( message );
+  }
+  
+  if(window)
+    glfwMakeContextCurrent(nullptr);   // context goes back to the graphics thread
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::apply_inbox(){
+  {
+    std::lock_guard lock(inbox_mutex);
+    std::swap(msgs_in_flight, msg_inbox);
+    std::swap(input_in_flight, input_inbox);
+  }
+  
+  // same order as on the graphics thread: input (polled first), then messages
+  for(auto& event : input_in_flight)
+    handle_input(event);
+  input_in_flight.clear();
+  
+  auto& manager = Manager::get_instance();
+  for(auto& msg : msgs_in_flight)
+    manager.exe_msg(msg);
+  msgs_in_flight.clear();
+}
+
+
+
+//------------------------------------------------------------------------------
+std::optional< gobj_type > Window::Wrapper::get_gobj_type(GShape& shape){
+  for(auto &mesh : meshes)
+    if(mesh.second == shape.get_mesh())
+      return mesh.first;
+  
+  return {};
+}
+
+
+
+//------------------------------------------------------------------------------
+std::shared_ptr< GMesh > Window::Wrapper::get_unit_mesh(gobj_type type){
+  auto mesh = meshes.find(type);
+  
+  if(mesh == meshes.end()){   // first gobject of this type -> create shared mesh
+    std::shared_ptr< GMesh > new_mesh;
+    
+    switch(type){
+    case t_triangle:  new_mesh = GTriangle::new_unit_mesh();   break;
+    case t_rectangle: new_mesh = GRect::new_unit_mesh();   break;
+    case t_circle:    new_mesh = GCircle::new_unit_mesh();   break;
+    default:          throw std::runtime_error("new_gobject(): Invalid GObject type!");
+    }
+    
+    mesh = meshes.insert( {type, new_mesh} ).first;
+  }
+  
+  return mesh->second;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Wrapper::run_exports(){
+  // all tiles in one go -> consistent image; the window pauses meanwhile
+  for(auto &request : exports){
+    try{
+      Tiled_Export exporter(request->path, request->width, request->height);
+      glm::vec4 region;
+      float pixel_scale;
+      
+      while( exporter.begin_tile(region, pixel_scale, (float)width) ){
+        set_background();
+        render_context->begin_frame(camera, (float)width, (float)height);
+        render_context->set_region(region, pixel_scale);
+        render_gobjects();
+        exporter.end_tile();
+      }
+      
+      exporter.finish();
+      request->done.set_value();
+    }
+    catch(std::exception& e){
+      request->done.set_exception( std::current_exception() );
+    }
+  }
+  exports.clear();
+  
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, width, height);
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Manager public
+////////////////////////////////////////////////////////////////////////////////
+
+Window::Manager& Window::Manager::get_instance(){
+  static Manager instance;   // the single instance
+  return instance;
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Manager::win_got_closed(id id){
+  if(id == 0  ||  id > next_win_id.load()  ||  id >= max_windows)
+    throw std::out_of_range("Window::got_closed(): Unknown window id!");
+  
+  auto segment = closed_segments[id / closed_segment_size].load(std::memory_order_acquire);
+  if( ! segment)   // no window of this segment closed yet
+    return false;
+  
+  return segment[id % closed_segment_size / 64].load(std::memory_order_acquire) & (std::uint64_t(1) << (id % 64));
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Window::Manager::get_count(){
+  return window_count.load(std::memory_order_acquire);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Manager::wait_lifecycle(const std::function< bool() >& done, std::chrono::milliseconds timeout){
+  std::unique_lock lock(lifecycle_mutex);
+  
+  if(timeout == std::chrono::milliseconds::max()){
+    lifecycle_changed.wait(lock, done);
+    return true;
+  }
+  
+  return lifecycle_changed.wait_for(lock, timeout, done);
+}
+
+
+
+//------------------------------------------------------------------------------
+int Window::Manager::get_lifecycle_fd(){
+  return lifecycle_fd;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::on_input(const Input_Event& event){
+  // built-in reactions are applied right away (GLFW callbacks run before the
+  // windows are updated) -> visible in the same frame
+  auto win = safe_get_window(event.win_id);
+  if( win.has_value() ){
+    if( win.value()->has_render_thread() )
+      win.value()->post(event);   // applied before its next frame
+    else
+      win.value()->handle_input(event);
+  }
+  
+  if(input_events.push(event)  &&  input_fd >= 0){
+    std::uint64_t one = 1;
+    [[maybe_unused]] auto written = write(input_fd, &one, sizeof(one));
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+std::size_t Window::Manager::poll_events(std::span< Input_Event > events){
+  return input_events.pop(events);
+}
+
+
+
+//------------------------------------------------------------------------------
+int Window::Manager::get_input_fd(){
+  return input_fd;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::push_msg_from_API(const Thread_Message& msg){
+  auto& manager = get_instance();
+  if(std::this_thread::get_id() == manager.graphics_thread.get_id()){   // its only consumer must never block on the queue
+    manager.push_msg_internal(msg);
+    return;
+  }
+  
+  auto& buffer = get_command_buffer();
+  buffer.msgs.push_back( msg );
+  
+  if(buffer.msgs.size() < buffer.chunk_size)
+    return;
+  
+  try{
+    get_instance().push_msgs_from_API(buffer.msgs);
+  }
+  catch(...){
+    if(buffer.chunk_size == 0)   // unbuffered: a rejected message is gone
+      buffer.msgs.clear();
+    throw;
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+Window::Command_Buffer& Window::Manager::get_command_buffer(){
+  thread_local Command_Buffer buffer;
+  return buffer;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::push_msgs_from_API(std::vector< Thread_Message >& msgs){
+  auto& queue = messages_from_API;
+  auto start = std::chrono::steady_clock::now();
+  
+  std::unique_lock lock(queue.mutex);
+  
+  // fail fast: all or nothing, messages stay in the caller's buffer
+  if(queue.capacity > 0  &&  queue.policy == q_fail  &&  queue.data.size() + msgs.size() > queue.capacity){
+    queue.stats.rejected += msgs.size();
+    throw std::runtime_error("Message queue is full");
+  }
+  
+  std::size_t sent = 0;
+  try{
+    for(auto& msg : msgs){
+      if(queue.capacity > 0  &&  queue.data.size() >= queue.capacity){
+        if(queue.policy == q_block){
+          queue.not_full.wait(lock, [&](){
+            return queue.capacity == 0  ||  queue.data.size() < queue.capacity  ||  stop_thread.load();
+          });
+        }
+        else if( !drop_msgs(queue) ){
+          queue.stats.rejected++;
+          throw std::runtime_error("Message queue is full and holds no droppable updates");
+        }
+      }
+      
+      if(recorder)
+        recorder->record( msg, std::chrono::steady_clock::now() );
+      if(msg.type == Thread_Message::open_win)   // counted once sent -> open(); wait_all_closed(); can't miss it
+        window_count.fetch_add(1, std::memory_order_release);
+      queue.data.push_back( std::move(msg) );
+      sent++;
+    }
+  }
+  catch(...){
+    msgs.erase(msgs.begin(), msgs.begin() + sent);
+    queue.stats.enqueued += sent;
+    throw;
+  }
+  
+  msgs.clear();
+  
+  double wait = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  queue.stats.enqueued += sent;
+  queue.stats.high_water = std::max(queue.stats.high_water, queue.data.size());
+  queue.stats.wait_total += wait;
+  queue.stats.wait_max = std::max(queue.stats.wait_max, wait);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_queue_capacity(std::size_t capacity, queue_policy policy){
+  {
+    std::lock_guard lock(messages_from_API.mutex);
+    messages_from_API.capacity = capacity;
+    messages_from_API.policy = policy;
+    messages_from_API.stats.high_water = messages_from_API.data.size();
+  }
+  
+  messages_from_API.not_full.notify_all();
+}
+
+
+
+//------------------------------------------------------------------------------
+Queue_Stats Window::Manager::get_queue_stats(){
+  std::lock_guard lock(messages_from_API.mutex);
+  Queue_Stats stats = messages_from_API.stats;
+  stats.depth = messages_from_API.data.size();
+  stats.capacity = messages_from_API.capacity;
+  
+  return stats;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::start_recording(const std::string& path){
+  auto new_recorder = std::make_shared< Command_Recorder >(path);
+  
+  std::lock_guard lock(messages_from_API.mutex);
+  if(recorder)
+    throw std::runtime_error("start_recording(): Already recording!");
+  
+  recorder = new_recorder;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::stop_recording(){
+  std::shared_ptr< Command_Recorder > old_recorder;
+  {
+    std::lock_guard lock(messages_from_API.mutex);
+    std::swap(old_recorder, recorder);
+  }
+  
+  if(old_recorder)
+    old_recorder->flush();   // throws if any write failed
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_headless(bool b){
+  headless.store(b);
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Manager::is_headless(){
+  return headless.load();
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Manager::has_glfw(){
+  return glfw_ready;
+}
+
+
+
+//------------------------------------------------------------------------------
+Job_System& Window::Manager::get_jobs(){
+  return jobs;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::publish_render_stats(id win_id, const Render_Stats& stats){
+  std::lock_guard lock(render_stats.mutex);
+  render_stats.data[win_id] = stats;
+}
+
+
+
+//------------------------------------------------------------------------------
+Render_Stats Window::Manager::get_render_stats(id win_id){
+  std::lock_guard lock(render_stats.mutex);
+  auto stats = render_stats.data.find(win_id);
+  if(stats == render_stats.data.end())
+    return {};
+  
+  return stats->second;
+}
+
+
+
+//------------------------------------------------------------------------------
+id Window::Manager::get_next_win_id(){
+  id win_id = get_instance().next_win_id.fetch_add(1) + 1;
+  if(win_id >= max_windows)
+    throw std::runtime_error("Window::open(): Too many windows opened!");
+  
+  return win_id;
+}
+
+
+
+//------------------------------------------------------------------------------
+id Window::Manager::get_next_gobj_id(){
+  // each thread takes a block of ids at once -> no shared counter per object
+  auto& buffer = get_command_buffer();
+  if(buffer.next_gobj_id == buffer.end_gobj_id){
+    buffer.next_gobj_id = get_instance().next_gobj_id.fetch_add(gobj_id_block, std::memory_order_relaxed);
+    buffer.end_gobj_id = buffer.next_gobj_id + gobj_id_block;
+  }
+  
+  return buffer.next_gobj_id++;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::reserve_ids(const Thread_Message& msg){
+  auto& manager = get_instance();
+  
+  // window id first, every further id is a gobject (or group/parent) id
+  std::visit( [&](const auto& param){
+    using T = std::decay_t< decltype(param) >;
+    if constexpr(std::is_same_v< T, id >)
+      raise_counter(manager.next_win_id, param);   // holds the last id handed out
+    else if constexpr(requires{ std::tuple_size< T >::value; }){
+      std::apply( [&](const auto& win_id, const auto&... rest){
+        raise_counter(manager.next_win_id, win_id);
+        auto reserve_gobj = [&](const auto& value){
+          if constexpr(std::is_same_v< std::decay_t< decltype(value) >, id >)
+            raise_counter(manager.next_gobj_id, value + 1);   // holds the next id to hand out
+        };
+        (reserve_gobj(rest), ...);
+      }, param );
+    }
+  }, msg.parameters );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Manager private
+////////////////////////////////////////////////////////////////////////////////
+
+Window::Manager::Manager(){
+  lifecycle_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  input_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  init_glfw();
+  graphics_thread = std::thread(&Window::Manager::thread_func, this);
+}
+
+
+
+//------------------------------------------------------------------------------
+Window::Manager::~Manager(){
+  stop_thread.store(true);
+  messages_from_API.not_full.notify_all();
+  graphics_thread.join();
+  
+  for(auto& w : windows)
+    w.second->stop_render_thread();   // before any window leaves the map
+  windows.clear();
+  
+  if(glfw_ready)
+    glfwTerminate();
+  
+  if(lifecycle_fd >= 0)
+    ::close(lifecycle_fd);
+  if(input_fd >= 0)
+    ::close(input_fd);
+  
+  for(auto& segment : closed_segments)
+    delete[] segment.load();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::init_glfw(){
+  if( ! glfwInit())
+    return;   // no display -> only software windows (Window::open() throws for GL windows)
+  
+  // use OpenGL version 3.3 core  
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  
+  // enable GLFW debugging
+  glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);   // remove in "release"!
+  
+  glfw_ready = true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::thread_func(){
+  try{  thread_loop();  }
+  
+  catch(std::exception& e){
+    std::string message = "Window::Manager: ";
+    message += e.what();
+    throw std::runtime_error( message );
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::thread_loop(){
+  while( ! stop_thread.load() ){
+    if(glfw_ready)
+      glfwPollEvents();
+    process_msgs_from_API();
+    update_windows();
+    wait_until_next_frame();
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::update_windows(){
+  for(auto &w : windows)
+    w.second->update(frame_delta);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::wait_until_next_frame(){
+  using namespace std::chrono;
+  using namespace std::chrono_literals;
+  
+  steady_clock::time_point now = steady_clock::now();
+  microsecs time_elapsed = duration_cast<microseconds>(now - prev_time).count();
+  prev_time = now;
+  
+  microsecs time_per_frame = 1000000 / fps;
+  microsecs wait_time = 0;
+  if(time_per_frame > time_elapsed)
+    wait_time = time_per_frame - time_elapsed;
+  
+  std::this_thread::sleep_for( microseconds(wait_time) );
+  
+  // real time between frames (used for animations)
+  steady_clock::time_point frame_start = steady_clock::now();
+  frame_delta = duration<float>(frame_start - prev_frame_start).count();
+  prev_frame_start = frame_start;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::push_msg_internal(const Thread_Message& msg){
+  // the graphics thread must never block on its own queue
+  std::lock_guard lock(messages_from_API.mutex);
+  messages_from_API.data.push_back( msg );
+}
+
+
+
+//------------------------------------------------------------------------------
+bool Window::Manager::drop_msgs(bounded_msg_queue& queue){
+  queue.stats.dropped += Message_Coalescer::remove_superseded(queue.data);
+  
+  while(queue.data.size() >= queue.capacity){
+    if( !Message_Coalescer::remove_oldest(queue.data) )
+      return false;
+    
+    queue.stats.dropped++;
+  }
+  
+  return true;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::process_msgs_from_API(){
+  // take everything queued so far in one lock; messages pushed while processing
+  // (by the API or by the graphics thread itself) wait for the next frame
+  std::deque< Thread_Message > msgs;
+  std::shared_ptr< Command_Recorder > rec;
+  {
+    std::lock_guard lock(messages_from_API.mutex);
+    std::swap(msgs, messages_from_API.data);
+    rec = recorder;
+  }
+  messages_from_API.not_full.notify_all();
+  
+  if(rec){   // file I/O outside the queue lock
+    try{  rec->flush();  }
+    catch(std::exception& e){}   // stream stays failed -> reported by stop_recording()
+  }
+  
+  while( !msgs.empty() ){
+    Thread_Message& msg = msgs.front();
+    
+    if( !coalescer.add(msg) ){
+      process_coalesced_msgs();   // keep order relative to barrier
+      process_msg(msg);
+    }
+    
+    msgs.pop_front();
+  }
+  
+  process_coalesced_msgs();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::process_coalesced_msgs(){
+  for(auto& msg : coalescer.pending())
+    process_msg(msg);
+  
+  coalescer.clear();
 }
 
 
 
 //------------------------------------------------------------------------------
 void Window::Manager::process_msg(Thread_Message& msg){
+  switch(msg.type){
+    case Thread_Message::open_win:
+    case Thread_Message::close_win:
+    case Thread_Message::set_window_name:   // GLFW: main thread only
+    case Thread_Message::set_render_thread:
+      break;
+    
+    default:{   // everything else belongs to the window's render thread (if any)
+      auto win_id = get_win_id(msg);
+      if( !win_id.has_value() )
+        break;
+      auto win = safe_get_window( win_id.value() );
+      if( win.has_value()  &&  win.value()->has_render_thread() ){
+        win.value()->post(msg);
+        return;
+      }
+    }
+  }
+  
+  exe_msg(msg);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::exe_msg(Thread_Message& msg){
   switch(msg.type){
     case Thread_Message::open_win:{
-      auto param = std::get< std::tuple< id, std::string > >(msg.parameters);
-      add_win(std::get<0>(param), std::get<1>(param));
+      auto param = std::get< std::tuple< id, std::string, render_backend > >(msg.parameters);
+      add_win(std::get<0>(param), std::get<1>(param), std::get<2>(param));
       break;
     }
     case Thread_Message::close_win:{
@@ -566,18 +2320,8 @@ void Window::Manager::process_msg(Thread_Message& msg){
       close_win(param);
       break;
     }
-    case Thread_Message::got_closed:{
-      auto param = std::get< id >(msg.parameters);
-      got_closed.at(param) = true;
-      break;
-    }
-    case Thread_Message::count_win:{
-      auto param = std::get< std::size_t >(msg.parameters);
-      window_count = param;
-      break;
-    }
     case Thread_Message::add_gobject:{
-      auto param = std::get< std::tuple< id, id, std::shared_ptr< GShape > > >(msg.parameters);
+      auto param = std::get< std::tuple< id, id, GObject_Descriptor > >(msg.parameters);
       add_new_gobject(std::get<0>(param), std::get<1>(param), std::get<2>(param));
       break;
     }
@@ -586,54 +2330,184 @@ void Window::Manager::process_msg(Thread_Message& msg){
       remove_gobject(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::clear_gobjects:{
-      auto param = std::get< id >(msg.parameters);
-      clear_gobjects(param);
+    case Thread_Message::clear_gobjects:{
+      auto param = std::get< id >(msg.parameters);
+      clear_gobjects(param);
+      break;
+    }
+    case Thread_Message::set_gobj_position:{
+      auto param = std::get< std::tuple<id, id, glm::vec3 > >(msg.parameters);
+      set_gobj_position(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_rotation:{
+      auto param = std::get< std::tuple<id, id, float > >(msg.parameters);
+      set_gobj_rotation(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_camera_position:{
+      auto param = std::get< std::tuple<id, glm::vec3 > >(msg.parameters);
+      set_camera_position(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_camera_zoom:{
+      auto param = std::get< std::tuple<id, float > >(msg.parameters);
+      set_camera_zoom(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::mod_camera_zoom:{
+      auto param = std::get< std::tuple<id, float > >(msg.parameters);
+      mod_camera_zoom(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_allow_zoom:{
+      auto param = std::get< std::tuple<id, bool > >(msg.parameters);
+      set_allow_zoom(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_allow_camera_movement:{
+      auto param = std::get< std::tuple<id, bool > >(msg.parameters);
+      set_allow_camera_movement(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_camera_inertia:{
+      auto param = std::get< std::tuple<id, bool > >(msg.parameters);
+      set_camera_inertia(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_background_colour:{
+      auto param = std::get< std::tuple<id, glm::vec3 > >(msg.parameters);
+      set_background_colour(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_window_name:{
+      auto param = std::get< std::tuple<id, std::string > >(msg.parameters);
+      set_window_name(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_render_thread:{
+      auto param = std::get< std::tuple<id, bool> >(msg.parameters);
+      set_render_thread(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::add_polyline:{
+      auto param = std::get< std::tuple<id, id, float, glm::vec3, std::size_t > >(msg.parameters);
+      add_polyline(std::get<0>(param), std::get<1>(param), std::get<2>(param), std::get<3>(param), std::get<4>(param));
+      break;
+    }
+    case Thread_Message::append_points:{
+      auto& param = std::get< std::tuple<id, id, std::vector< glm::vec2 > > >(msg.parameters);
+      append_points(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::add_point_set:{
+      auto param = std::get< std::tuple<id, id, std::shared_ptr< const Point_Data > > >(msg.parameters);
+      add_point_set(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::update_points:{
+      auto param = std::get< std::tuple<id, id, std::shared_ptr< const Point_Data > > >(msg.parameters);
+      update_points(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_static:{
+      auto param = std::get< std::tuple<id, id, bool > >(msg.parameters);
+      set_gobj_static(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_auto_static:{
+      auto param = std::get< std::tuple<id, std::size_t > >(msg.parameters);
+      set_auto_static(std::get<0>(param), std::get<1>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_layer:{
+      auto param = std::get< std::tuple<id, id, int > >(msg.parameters);
+      set_gobj_layer(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::add_image:{
+      auto param = std::get< std::tuple<id, id, std::shared_ptr< const Image_Data > > >(msg.parameters);
+      add_image(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::add_sprite:{
+      auto param = std::get< std::tuple<id, id, Sprite_Descriptor > >(msg.parameters);
+      add_sprite(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::add_text:{
+      auto& param = std::get< std::tuple<id, id, Text_Descriptor > >(msg.parameters);
+      add_text(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::animate:{
+      auto param = std::get< std::tuple<id, id, Tween_Descriptor > >(msg.parameters);
+      animate(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_velocity:{
+      auto param = std::get< std::tuple<id, id, glm::vec2 > >(msg.parameters);
+      set_gobj_velocity(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_acceleration:{
+      auto param = std::get< std::tuple<id, id, glm::vec2 > >(msg.parameters);
+      set_gobj_acceleration(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::set_gobj_angular_velocity:{
+      auto param = std::get< std::tuple<id, id, float > >(msg.parameters);
+      set_gobj_angular_velocity(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+      break;
+    }
+    case Thread_Message::add_group:{
+      auto param = std::get< std::tuple<id, id, glm::vec3, float > >(msg.parameters);
+      add_group(std::get<0>(param), std::get<1>(param), std::get<2>(param), std::get<3>(param));
       break;
     }
-    case Thread_Message::set_gobj_position:{
-      auto param = std::get< std::tuple<id, id, glm::vec3 > >(msg.parameters);
-      set_gobj_position(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+    case Thread_Message::set_gobj_parent:{
+      auto param = std::get< std::tuple<id, id, id > >(msg.parameters);
+      set_gobj_parent(std::get<0>(param), std::get<1>(param), std::get<2>(param));
       break;
     }
-    case Thread_Message::set_gobj_rotation:{
-      auto param = std::get< std::tuple<id, id, float > >(msg.parameters);
-      set_gobj_rotation(std::get<0>(param), std::get<1>(param), std::get<2>(param));
+    case Thread_Message::remove_gobj_parent:{
+      auto param = std::get< std::tuple<id, id > >(msg.parameters);
+      remove_gobj_parent(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_camera_position:{
-      auto param = std::get< std::tuple<id, glm::vec3 > >(msg.parameters);
-      set_camera_position(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::share_scene:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Shared_Scene > > >(msg.parameters);
+      share_scene(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_camera_zoom:{
-      auto param = std::get< std::tuple<id, float > >(msg.parameters);
-      set_camera_zoom(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::pick:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Pick_Request > > >(msg.parameters);
+      pick(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::mod_camera_zoom:{
-      auto param = std::get< std::tuple<id, float > >(msg.parameters);
-      mod_camera_zoom(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::export_image:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Export_Request > > >(msg.parameters);
+      export_image(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_allow_zoom:{
-      auto param = std::get< std::tuple<id, bool > >(msg.parameters);
-      set_allow_zoom(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::save_snapshot:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Snapshot_Request > > >(msg.parameters);
+      save_snapshot(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_allow_camera_movement:{
-      auto param = std::get< std::tuple<id, bool > >(msg.parameters);
-      set_allow_camera_movement(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::load_snapshot:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Scene_Snapshot > > >(msg.parameters);
+      load_snapshot(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_background_colour:{
-      auto param = std::get< std::tuple<id, glm::vec3 > >(msg.parameters);
-      set_background_colour(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::capture:{
+      auto param = std::get< std::tuple<id, std::shared_ptr< Capture_Request > > >(msg.parameters);
+      capture(std::get<0>(param), std::get<1>(param));
       break;
     }
-    case Thread_Message::set_window_name:{
-      auto param = std::get< std::tuple<id, std::string > >(msg.parameters);
-      set_window_name(std::get<0>(param), std::get<1>(param));
+    case Thread_Message::set_text:{
+      auto& param = std::get< std::tuple<id, id, std::string > >(msg.parameters);
+      set_text(std::get<0>(param), std::get<1>(param), std::get<2>(param));
       break;
     }
   }
@@ -642,37 +2516,74 @@ void Window::Manager::process_msg(Thread_Message& msg){
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::add_win(id win_id, const std::string& name){
-  windows.insert({
-    win_id,
-    std::make_shared< Wrapper >(win_id)
-  });
+void Window::Manager::add_win(id win_id, const std::string& name, render_backend backend){
+  auto win = std::make_shared< Wrapper >(win_id, backend);
+  {
+    std::unique_lock lock(windows_mutex);
+    windows.insert( {win_id, win} );
+  }
+  
+  notify_lifecycle();
   
-  Thread_Message msg = {Thread_Message::count_win, windows.size()};
-  push_msg_to_API(msg);
-  msg = {Thread_Message::set_window_name, std::make_tuple(win_id, name) };
-  push_msg_from_API(msg);
+  Thread_Message msg = {Thread_Message::set_window_name, std::make_tuple(win_id, name) };
+  push_msg_internal(msg);
 }
 
 
 
 //------------------------------------------------------------------------------
 void Window::Manager::close_win(id id){
-  windows.erase(id);
+  auto win = safe_get_window(id);
+  if( win.has_value() )
+    win.value()->stop_render_thread();   // joined while the window is still reachable
+  
+  bool erased;
+  {
+    std::unique_lock lock(windows_mutex);
+    erased = windows.erase(id) > 0;
+  }
+  
+  {
+    std::lock_guard lock(render_stats.mutex);
+    render_stats.data.erase(id);
+  }
+  
+  if(id < max_windows){   // else: never handed out (e.g. Window::close() with a made-up id)
+    auto& slot = closed_segments[id / closed_segment_size];
+    auto segment = slot.load(std::memory_order_relaxed);   // only written by this thread
+    if( ! segment){
+      segment = new std::atomic< std::uint64_t >[closed_segment_size / 64]();
+      slot.store(segment, std::memory_order_release);
+    }
+    segment[id % closed_segment_size / 64].fetch_or(std::uint64_t(1) << (id % 64), std::memory_order_release);
+  }
+  if(erased)   // repeated close requests count once
+    window_count.fetch_sub(1, std::memory_order_release);
+  notify_lifecycle();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::notify_lifecycle(){
+  {
+    std::lock_guard lock(lifecycle_mutex);   // no lost wake-up between check & wait
+  }
+  lifecycle_changed.notify_all();
   
-  Thread_Message msg = {Thread_Message::count_win, windows.size()};
-  push_msg_to_API(msg);
-  msg = {Thread_Message::got_closed, id};
-  push_msg_to_API(msg);
+  if(lifecycle_fd >= 0){
+    std::uint64_t one = 1;
+    [[maybe_unused]] auto written = write(lifecycle_fd, &one, sizeof(one));
+  }
 }
 
 
 
 //------------------------------------------------------------------------------
-void Window::Manager::add_new_gobject(id win_id, id gobj_id, std::shared_ptr< GShape > obj){
+void Window::Manager::add_new_gobject(id win_id, id gobj_id, const GObject_Descriptor& desc){
   auto win = safe_get_window(win_id);
   if( win.has_value() )
-    win.value()->graphics_objects.insert( {gobj_id, obj} );
+    win.value()->add_gobject(gobj_id, win.value()->new_gobject(desc));
 }
 
 
@@ -681,7 +2592,7 @@ void Window::Manager::add_new_gobject(id win_id, id gobj_id, std::shared_ptr< GS
 void Window::Manager::remove_gobject(id win_id, id gobj_id){
   auto win = safe_get_window(win_id);
   if( win.has_value() )
-    win.value()->graphics_objects.erase(gobj_id);
+    win.value()->remove_gobject(gobj_id);
 }
 
 
@@ -690,7 +2601,7 @@ void Window::Manager::remove_gobject(id win_id, id gobj_id){
 void Window::Manager::clear_gobjects(id win_id){
   auto win = safe_get_window(win_id);
   if( win.has_value() )
-    win.value()->graphics_objects.clear();
+    win.value()->clear_gobjects();
 }
 
 
@@ -698,8 +2609,11 @@ void Window::Manager::clear_gobjects(id win_id){
 //------------------------------------------------------------------------------
 void Window::Manager::set_gobj_position(id win_id, id gobj_id, glm::vec3 position){
   auto win = safe_get_window(win_id);
-  if( win.has_value() )
-    win.value()->graphics_objects.at(gobj_id)->set_position(position);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->get_gobject(gobj_id)->set_position(position);
+  win.value()->gobject_changed(gobj_id);
 }
 
 
@@ -707,8 +2621,11 @@ void Window::Manager::set_gobj_position(id win_id, id gobj_id, glm::vec3 positio
 //------------------------------------------------------------------------------
 void Window::Manager::set_gobj_rotation(id win_id, id gobj_id, float rotation){
   auto win = safe_get_window(win_id);
-  if( win.has_value() )
-    win.value()->graphics_objects.at(gobj_id)->set_rotation(rotation);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->get_gobject(gobj_id)->set_rotation(rotation);
+  win.value()->gobject_changed(gobj_id);
 }
 
 
@@ -716,8 +2633,11 @@ void Window::Manager::set_gobj_rotation(id win_id, id gobj_id, float rotation){
 //------------------------------------------------------------------------------
 void Window::Manager::set_camera_position(id win_id, glm::vec3 pos){
   auto win = safe_get_window(win_id);
-  if( win.has_value() )
-    win.value()->camera.set_position(pos);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->navigation.stop();   // explicit position wins over drag & inertia
+  win.value()->camera.set_position(pos);
 }
 
 
@@ -751,9 +2671,22 @@ void Window::Manager::set_allow_zoom(id win_id, bool b){
 
 //------------------------------------------------------------------------------
 void Window::Manager::set_allow_camera_movement(id win_id, bool b){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->allow_camera_movement = b;
+  if( !b )
+    win.value()->navigation.stop();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_camera_inertia(id win_id, bool b){
   auto win = safe_get_window(win_id);
   if( win.has_value() )
-    win.value()->allow_camera_movement = b;
+    win.value()->navigation.inertia = b;
 }
 
 
@@ -777,57 +2710,298 @@ void Window::Manager::set_window_name(id win_id, const std::string& name){
 
 
 //------------------------------------------------------------------------------
-std::optional< std::shared_ptr< Window::Wrapper > > Window::Manager::safe_get_window(id win_id){
-  try{  return windows.at(win_id);  }
-  catch(std::out_of_range& e){  return {};  }   // window not found -> return empty
+void Window::Manager::set_render_thread(id win_id, bool b){
+  auto win = safe_get_window(win_id);
+  if( !win.has_value() )
+    return;
+  
+  if(b)
+    win.value()->start_render_thread();
+  else
+    win.value()->stop_render_thread();
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::add_polyline(id win_id, id line_id, float thickness, glm::vec3 colour, std::size_t capacity){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->add_gobject(line_id, std::make_shared< GPolyline >(thickness, colour, capacity));
 }
 
 
 
 //------------------------------------------------------------------------------
-std::shared_ptr< GShape > Window::Manager::new_gobject(gobj_type g_type, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > obj;
+void Window::Manager::append_points(id win_id, id line_id, const std::vector< glm::vec2 >& points){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
   
-  switch(g_type){
-  case t_triangle:  obj = std::make_shared< GTriangle >(size, colour);   break;
-  case t_rectangle: obj = std::make_shared< GRect >(size, colour);   break;
-  case t_circle:    obj = std::make_shared< GCircle >(size, colour);   break;
-  default:          throw std::runtime_error("new_gobject(): Invalid GObject type!");
-  }
+  auto line = std::dynamic_pointer_cast< GPolyline >( win.value()->get_gobject(line_id) );
+  if(line)
+    line->append_points(points);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::add_point_set(id win_id, id set_id, std::shared_ptr< const Point_Data > data){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->add_gobject(set_id, std::make_shared< GPoint_Set >(data));
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::update_points(id win_id, id set_id, std::shared_ptr< const Point_Data > data){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  auto point_set = std::dynamic_pointer_cast< GPoint_Set >( win.value()->get_gobject(set_id) );
+  if(point_set)
+    point_set->update(data);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_static(id win_id, id gobj_id, bool b){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->set_gobj_static(gobj_id, b);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_auto_static(id win_id, std::size_t frames){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->auto_static_frames = frames;
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_layer(id win_id, id gobj_id, int layer){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
   
-  return obj;
+  win.value()->get_gobject(gobj_id)->set_layer(layer);
+  win.value()->gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::add_image(id win_id, id image_id, std::shared_ptr< const Image_Data > image){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->atlas.add(image_id, image);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::add_sprite(id win_id, id sprite_id, const Sprite_Descriptor& desc){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->add_gobject(sprite_id, std::make_shared< GSprite >(desc.image, desc.position, desc.rotation, desc.size));
 }
 
 
 
 //------------------------------------------------------------------------------
-std::shared_ptr< GShape > Window::Manager::new_gobject(gobj_type g_type, glm::vec3 position, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > obj;
+void Window::Manager::add_text(id win_id, id text_id, const Text_Descriptor& desc){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
   
-  switch(g_type){
-  case t_triangle:  obj = std::make_shared< GTriangle >(position, size, colour);   break;
-  case t_rectangle: obj = std::make_shared< GRect >(position, size, colour);   break;
-  case t_circle:    obj = std::make_shared< GCircle >(position, size, colour);   break;
-  default:          throw std::runtime_error("new_gobject(): Invalid GObject type!");
-  }
+  auto& atlas = win.value()->atlas;
+  if( ! atlas.get(Bitmap_Font::image_id) )   // first label of this window
+    atlas.add(Bitmap_Font::image_id, Bitmap_Font::get_image());
   
-  return obj;
+  win.value()->add_gobject(text_id, std::make_shared< GText >(desc.text, desc.position, desc.size, desc.colour));
 }
 
 
 
 //------------------------------------------------------------------------------
-std::shared_ptr< GShape > Window::Manager::new_gobject(gobj_type g_type, glm::vec3 position, float rotation, float size, glm::vec3 colour){
-  std::shared_ptr< GShape > obj;
+void Window::Manager::set_text(id win_id, id text_id, const std::string& text){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
   
-  switch(g_type){
-  case t_triangle:  obj = std::make_shared< GTriangle >(position, rotation, size, colour);   break;
-  case t_rectangle: obj = std::make_shared< GRect >(position, rotation, size, colour);   break;
-  case t_circle:    obj = std::make_shared< GCircle >(position, rotation, size, colour);   break;
-  default:          throw std::runtime_error("new_gobject(): Invalid GObject type!");
-  }
+  auto label = std::dynamic_pointer_cast< GText >( win.value()->get_gobject(text_id) );
+  if(label)
+    label->set_text(text);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::animate(id win_id, id gobj_id, const Tween_Descriptor& desc){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->animate(gobj_id, desc);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_velocity(id win_id, id gobj_id, glm::vec2 velocity){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->kinematics.set_velocity(gobj_id, win.value()->get_gobject(gobj_id), velocity);
+  win.value()->gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_acceleration(id win_id, id gobj_id, glm::vec2 acceleration){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->kinematics.set_acceleration(gobj_id, win.value()->get_gobject(gobj_id), acceleration);
+  win.value()->gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_angular_velocity(id win_id, id gobj_id, float angular_velocity){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->kinematics.set_angular_velocity(gobj_id, win.value()->get_gobject(gobj_id), angular_velocity);
+  win.value()->gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::add_group(id win_id, id group_id, glm::vec3 position, float rotation){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->add_group(group_id, std::make_shared< GGroup >(position, rotation));
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::set_gobj_parent(id win_id, id gobj_id, id parent_id){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->set_gobj_parent(gobj_id, parent_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::remove_gobj_parent(id win_id, id gobj_id){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
+  
+  win.value()->hierarchy.remove_parent(gobj_id);
+  win.value()->gobject_changed(gobj_id);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::share_scene(id win_id, std::shared_ptr< Shared_Scene > scene){
+  auto win = safe_get_window(win_id);
+  if( ! win.has_value() )
+    return;
   
-  return obj;
+  win.value()->share_scene(scene);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::pick(id win_id, std::shared_ptr< Pick_Request > request){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->pick(request);   // else: dropped request -> broken promise
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::export_image(id win_id, std::shared_ptr< Export_Request > request){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->export_image(request);   // else: dropped request -> broken promise
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::save_snapshot(id win_id, std::shared_ptr< Snapshot_Request > request){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->save_snapshot(request);   // else: dropped request -> broken promise
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::load_snapshot(id win_id, std::shared_ptr< Scene_Snapshot > snapshot){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->load_snapshot(snapshot);
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::capture(id win_id, std::shared_ptr< Capture_Request > request){
+  auto win = safe_get_window(win_id);
+  if( win.has_value() )
+    win.value()->capture(request);   // else: dropped request -> broken promise
+}
+
+
+
+//------------------------------------------------------------------------------
+std::optional< std::shared_ptr< Window::Wrapper > > Window::Manager::safe_get_window(id win_id){
+  std::shared_lock lock(windows_mutex);
+  try{  return windows.at(win_id);  }
+  catch(std::out_of_range& e){  return {};  }   // window not found -> return empty
+}
+
+
+
+//------------------------------------------------------------------------------
+void Window::Manager::raise_counter(std::atomic< id >& counter, id value){
+  id current = counter.load(std::memory_order_relaxed);
+  while(current < value  &&  !counter.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+
+
+//------------------------------------------------------------------------------
+std::optional< id > Window::Manager::get_win_id(const Thread_Message& msg){
+  return std::visit( [](const auto& param) -> std::optional< id > {
+    using T = std::decay_t< decltype(param) >;
+    if constexpr(std::is_same_v< T, id >)
+      return param;
+    else if constexpr(requires{ std::tuple_size< T >::value; })
+      return std::get<0>(param);   // all tuples start with the window id
+    else
+      return {};
+  }, msg.parameters );
 }
 
 
@@ -847,8 +3021,60 @@ void glfw_error(int error, const char* description){
 
 //------------------------------------------------------------------------------
 void scroll_callback(GLFWwindow* window, double x_offset, double y_offset){
-  auto win_id = (id) glfwGetWindowUserPointer(window);
-  Window::mod_camera_zoom(win_id, - y_offset * 0.1f);
+  Input_Event event;
+  event.win_id = (id) glfwGetWindowUserPointer(window);
+  event.type = in_scroll;
+  event.value = glm::vec2(x_offset, y_offset);
+  event.time = std::chrono::steady_clock::now();
+  
+  Window::Manager::get_instance().on_input(event);
+}
+
+
+
+//------------------------------------------------------------------------------
+void key_callback(GLFWwindow* window, int key, [[maybe_unused]] int scancode, int action, int mods){
+  Input_Event event;
+  event.win_id = (id) glfwGetWindowUserPointer(window);
+  event.type = in_key;
+  event.code = key;
+  event.action = action;
+  event.mods = mods;
+  event.time = std::chrono::steady_clock::now();
+  
+  Window::Manager::get_instance().on_input(event);
+}
+
+
+
+//------------------------------------------------------------------------------
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods){
+  double x, y;
+  glfwGetCursorPos(window, &x, &y);
+  
+  Input_Event event;
+  event.win_id = (id) glfwGetWindowUserPointer(window);
+  event.type = in_mouse_button;
+  event.code = button;
+  event.action = action;
+  event.mods = mods;
+  event.value = glm::vec2(x, y);
+  event.time = std::chrono::steady_clock::now();
+  
+  Window::Manager::get_instance().on_input(event);
+}
+
+
+
+//------------------------------------------------------------------------------
+void cursor_callback(GLFWwindow* window, double x, double y){
+  Input_Event event;
+  event.win_id = (id) glfwGetWindowUserPointer(window);
+  event.type = in_cursor;
+  event.value = glm::vec2(x, y);
+  event.time = std::chrono::steady_clock::now();
+  
+  Window::Manager::get_instance().on_input(event);
 }
 
 
@@ -897,4 +3123,4 @@ void APIENTRY glDebugOutput(GLenum source,
   } std::cout << "\n";
   
   std::cout << "\n";
-}
\ No newline at end of file
+}
@@ -31,11 +31,17 @@ SOFTWARE.
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <atomic>
 #include <unordered_map>
-#include <queue>
+#include <array>
+#include <functional>
+#include <deque>
+#include <condition_variable>
 #include <chrono>
 #include <optional>
+#include <span>
+#include <future>
 
 ///#define GLFW_INCLUDE_NONE     // not needed/working on Ubuntu, etc.
 // #include <glad/gl.h>     // not needed/working on Ubuntu, etc.
@@ -48,6 +54,31 @@ SOFTWARE.
 
 #include "shader_program.h"
 #include "graphics_object.h"
+#include "graphics_polyline.h"
+#include "graphics_point_set.h"
+#include "render_context.h"
+#include "static_batch.h"
+#include "render_queue.h"
+#include "shape_batch.h"
+#include "texture_atlas.h"
+#include "graphics_sprite.h"
+#include "sprite_batch.h"
+#include "graphics_text.h"
+#include "bitmap_font.h"
+#include "tween_engine.h"
+#include "kinematics.h"
+#include "graphics_group.h"
+#include "transform_hierarchy.h"
+#include "message_coalescer.h"
+#include "input_ring.h"
+#include "navigation.h"
+#include "picker.h"
+#include "tiled_export.h"
+#include "scene_snapshot.h"
+#include "snapshot_layer.h"
+#include "command_recorder.h"
+#include "soft_rasterizer.h"
+#include "job_system.h"
 #include "camera.h"
 #include "utils.h"
 
@@ -57,23 +88,20 @@ SOFTWARE.
 
 
 
-// used by API
-enum gobj_type{
-  t_triangle,
-  t_rectangle,
-  t_circle
-};
-
-
-
 class Window{   // outer Window class exposes only the API
 public:
   // API
   static id open();
   static id open(const std::string& name);
+  static id open(const std::string& name, render_backend backend);
   static void close(id win_id);
   static bool got_closed(id win_id);
   static std::size_t count();
+  static bool wait_closed(id win_id, std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+  static bool wait_all_closed(std::chrono::milliseconds timeout = std::chrono::milliseconds::max());
+  static int get_lifecycle_fd();
+  static std::size_t poll_events(std::span< Input_Event > events);
+  static int get_input_fd();
   static id add_gobject(id win_id, gobj_type g_type, float size, glm::vec3 colour);
   static id add_gobject(id win_id, gobj_type g_type, glm::vec3 position, float size, glm::vec3 colour);
   static id add_gobject(id win_id, gobj_type g_type, glm::vec3 position, float rotation, float size, glm::vec3 colour);
@@ -86,8 +114,51 @@ public:
   static void mod_camera_zoom(id win_id, float zoom_diff);
   static void set_allow_zoom(id win_id, bool b);
   static void set_allow_camera_movement(id win_id, bool b);
+  static void set_camera_inertia(id win_id, bool b);
   static void set_background_colour(id win_id, glm::vec3 colour);
   static void set_window_name(id win_id, const std::string& name);
+  static void set_render_thread(id win_id, bool b);
+  static id add_polyline(id win_id, float thickness, glm::vec3 colour, std::size_t capacity = 10000);
+  static void append_points(id win_id, id line_id, std::span< const glm::vec2 > points);
+  static id add_point_set(id win_id, std::span< const glm::vec2 > positions, glm::vec3 colour, float size);
+  static id add_point_set(id win_id, std::span< const glm::vec2 > positions, std::span< const glm::vec3 > colours, std::span< const float > sizes, glm::vec3 default_colour = {1.0f, 1.0f, 1.0f}, float default_size = 1.0f);
+  static void update_points(id win_id, id set_id, std::size_t first, std::span< const glm::vec2 > positions, std::span< const glm::vec3 > colours = {}, std::span< const float > sizes = {});
+  static void set_gobj_static(id win_id, id gobj_id, bool b);
+  static void set_auto_static(id win_id, std::size_t frames);
+  static void set_gobj_layer(id win_id, id gobj_id, int layer);
+  static id add_image(id win_id, std::size_t width, std::size_t height, std::span< const std::uint8_t > rgba);
+  static id add_sprite(id win_id, id image_id, glm::vec3 position, float rotation, float size);
+  static id add_text(id win_id, const std::string& text, glm::vec3 position, float size, glm::vec3 colour);
+  static void set_text(id win_id, id text_id, const std::string& text);
+  static void animate_position(id win_id, id gobj_id, glm::vec3 target, float duration, easing ease = e_linear);
+  static void animate_rotation(id win_id, id gobj_id, float target, float duration, easing ease = e_linear);
+  static void animate_scale(id win_id, id gobj_id, float target, float duration, easing ease = e_linear);
+  static void animate_colour(id win_id, id gobj_id, glm::vec3 target, float duration, easing ease = e_linear);
+  static void animate_camera_position(id win_id, glm::vec3 target, float duration, easing ease = e_linear);
+  static void animate_camera_zoom(id win_id, float target, float duration, easing ease = e_linear);
+  static void set_gobj_velocity(id win_id, id gobj_id, glm::vec2 velocity);
+  static void set_gobj_acceleration(id win_id, id gobj_id, glm::vec2 acceleration);
+  static void set_gobj_angular_velocity(id win_id, id gobj_id, float angular_velocity);
+  static id add_group(id win_id, glm::vec3 position, float rotation = 0.0f);
+  static void set_gobj_parent(id win_id, id gobj_id, id parent_id);
+  static void remove_gobj_parent(id win_id, id gobj_id);
+  static std::shared_ptr< Shared_Scene > share_scene(id win_id, std::span< const id > gobj_ids);
+  static void unshare_scene(id win_id);
+  static std::future< std::optional< id > > pick(id win_id, int x, int y);
+  static std::future< std::vector< id > > pick_rect(id win_id, int x, int y, int width, int height);
+  static std::future< void > export_image(id win_id, const std::string& path, std::size_t width, std::size_t height);
+  static std::future< void > save_snapshot(id win_id, const std::string& path);
+  static std::future< Image_Data > capture(id win_id);
+  static void load_snapshot(id win_id, const std::string& path);
+  static Render_Stats get_render_stats(id win_id);
+  static void set_queue_capacity(std::size_t capacity, queue_policy policy = q_block);
+  static Queue_Stats get_queue_stats();
+  static void set_command_buffering(std::size_t chunk_size);
+  static void flush_commands();
+  static void start_recording(const std::string& path);
+  static void stop_recording();
+  static Replay_Stats replay(const std::string& path, replay_timing timing = r_original);
+  static void set_headless(bool b);
   
   
   
@@ -95,47 +166,148 @@ private:
   Window() = delete;   // Window class acts as a static API
   ~Window() = delete;   // Window class acts as a static API
   
+  static void push_tween(id win_id, id gobj_id, const Tween_Descriptor& desc);
+  
+  // GLFW input callbacks (graphics thread)
+  friend void scroll_callback(GLFWwindow* window, double x_offset, double y_offset);
+  friend void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+  friend void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+  friend void cursor_callback(GLFWwindow* window, double x, double y);
+  
   
   
   // thread communication
   typedef struct{
-    std::queue< Thread_Message > data;
+    std::deque< Thread_Message > data;
+    std::mutex mutex;
+    std::condition_variable not_full;
+    std::size_t capacity = 0;   // 0 = unbounded
+    queue_policy policy = q_block;
+    Queue_Stats stats;
+  }bounded_msg_queue;
+  
+  // one per producer thread (thread_local)
+  struct Command_Buffer{
+    std::vector< Thread_Message > msgs;
+    std::size_t chunk_size = 0;   // 0 = send every message immediately
+    id next_gobj_id = 0;   // reserved id range [next_gobj_id, end_gobj_id)
+    id end_gobj_id = 0;
+    ~Command_Buffer();   // flushes remaining messages on thread exit
+  };
+  
+  typedef struct{
+    std::unordered_map< id, Render_Stats > data;
     std::mutex mutex;
-  }thread_msg_queue;
+  }render_stats_table;
   
   
   
 //------------------------------------------------------------------------------
   // wrapper class (holds actual window)
+  // with a render thread, everything marked "graphics thread" runs on that
+  // thread instead (except for the functions marked "graphics thread only")
   class Wrapper{
   public:
-    Wrapper(id w_id);   // graphics thread
+    Wrapper(id w_id, render_backend backend);   // graphics thread
     ~Wrapper();   // graphics thread
-    void update();   // graphics thread
+    void update(float delta_time);   // graphics thread
     void update_name(const std::string& name);   // graphics thread
+    std::shared_ptr< GShape > new_gobject(const GObject_Descriptor& desc);   // graphics thread
+    void add_gobject(id gobj_id, std::shared_ptr< GObject > obj);   // graphics thread
+    std::shared_ptr< GObject > get_gobject(id gobj_id);   // graphics thread (throws std::out_of_range)
+    void gobject_changed(id gobj_id);   // graphics thread (call after moving/rotating)
+    void remove_gobject(id gobj_id);   // graphics thread
+    void clear_gobjects();   // graphics thread
+    void set_gobj_static(id gobj_id, bool b);   // graphics thread
+    void animate(id gobj_id, const Tween_Descriptor& desc);   // graphics thread (gobj_id ignored for camera)
+    void add_group(id group_id, std::shared_ptr< GGroup > group);   // graphics thread
+    void set_gobj_parent(id gobj_id, id parent_id);   // graphics thread
+    void share_scene(std::shared_ptr< Shared_Scene > scene);   // graphics thread (nullptr = stop sharing)
+    void handle_input(const Input_Event& event);   // graphics thread (built-in navigation)
+    void pick(std::shared_ptr< Pick_Request > request);   // graphics thread (window coordinates)
+    void export_image(std::shared_ptr< Export_Request > request);   // graphics thread (runs after next frame)
+    void save_snapshot(std::shared_ptr< Snapshot_Request > request);   // graphics thread
+    void load_snapshot(std::shared_ptr< Scene_Snapshot > snapshot);   // graphics thread (replaces all gobjects)
+    void capture(std::shared_ptr< Capture_Request > request);   // graphics thread (fulfilled by next frame)
+    void start_render_thread();   // graphics thread only
+    void stop_render_thread();   // graphics thread only (applies messages that are still waiting)
+    bool has_render_thread();   // graphics thread only
+    void post(const Thread_Message& msg);   // graphics thread only (applied by the render thread)
+    void post(const Input_Event& event);   // graphics thread only (applied by the render thread)
     
-    std::unordered_map< id, std::shared_ptr< GShape > > graphics_objects;   // graphics thread
+    std::unordered_map< id, std::shared_ptr< GObject > > graphics_objects;   // graphics thread (dynamic; only modify through member functions)
+    Static_Batch static_batch;   // graphics thread
+    Snapshot_Layer snapshot_layer;   // graphics thread (restored GShapes)
+    Texture_Atlas atlas;   // graphics thread
+    Kinematics kinematics;   // graphics thread
+    Transform_Hierarchy hierarchy;   // graphics thread
+    std::size_t auto_static_frames = 0;   // graphics thread (bake GShapes unmoved for this many frames; 0 = off)
     Camera camera;   // graphics thread
+    Navigation navigation;   // graphics thread
     bool allow_zoom = false;   // graphics thread
     bool allow_camera_movement = false;   // graphics thread
     glm::vec3 background_colour = {0.0f, 0.0f, 0.0f};   // graphics thread
-    std::string window_name = "";   // graphics thread (after initialization)
+    std::string window_name = "";   // graphics thread only (after initialization)
     
   private:
     id w_id;   // graphics thread (after initialization)
-    GLFWwindow* window;   // graphics thread (after initialization)
-    int width, height;   // graphics thread (after initialization)
-    std::shared_ptr< Shader_Program > shader_program;   // graphics thread (after initialization)
+    render_backend backend;   // graphics thread (after initialization)
+    GLFWwindow* window = nullptr;   // graphics thread (after initialization; nullptr for software windows)
+    Job_System& jobs;   // graphics thread (owned by Manager)
+    std::unique_ptr< Soft_Rasterizer > rasterizer;   // graphics thread (software windows only)
+    std::vector< std::shared_ptr< Capture_Request > > captures;   // graphics thread (waiting for next frame)
+    int width = 0, height = 0;   // graphics thread (after initialization)
+    std::shared_ptr< Render_Context > render_context;   // graphics thread (after initialization)
+    Render_Queue render_queue;   // graphics thread
+    Shape_Batch shape_batch;   // graphics thread
+    std::vector< GShape* > shape_run;   // graphics thread (consecutive GShapes of the render queue)
+    std::vector< int > baked_layers;   // graphics thread (layers of static_batch; refilled per pass)
+    Tween_Engine tweens;   // graphics thread
+    std::unordered_map< id, std::shared_ptr< GGroup > > groups;   // graphics thread (not rendered)
+    std::shared_ptr< Shared_Scene > shared_scene;   // graphics thread (opt-in)
+    std::vector< std::shared_ptr< GObject > > shared_objs;   // graphics thread (one per slot; nullptr if removed)
+    Sprite_Batch sprite_batch;   // graphics thread
+    Picker picker;   // graphics thread
+    std::vector< std::shared_ptr< Export_Request > > exports;   // graphics thread (waiting for next frame)
+    std::unordered_map< gobj_type, std::shared_ptr< GMesh > > meshes;   // graphics thread (shared by all gobjects of one type)
+    std::thread render_thread;   // optional; owns the GL context while running
+    bool on_render_thread = false;   // graphics thread only (set before starting, reset after joining)
+    std::atomic< bool > stop_render = false;   // both threads
+    std::mutex inbox_mutex;   // both threads
+    std::vector< Thread_Message > msg_inbox;   // both threads (guarded by inbox_mutex)
+    std::vector< Input_Event > input_inbox;   // both threads (guarded by inbox_mutex)
+    std::vector< Thread_Message > msgs_in_flight;   // render thread
+    std::vector< Input_Event > input_in_flight;   // render thread
+    std::atomic< int > fb_width = 0, fb_height = 0;   // graphics thread -> render thread (GLFW size queries are main thread only)
+    std::atomic< int > win_width = 0, win_height = 0;   // graphics thread -> render thread
+    glm::vec2 cursor = {0.0f, 0.0f};   // graphics thread (last cursor event; window coordinates)
+    static constexpr uint render_fps = 60;   // render thread
     
     void create_glfw_window();
     void load_gl_functions();
     void enable_gl_debugging();
-    void setup_shader_program();
+    void setup_render_context();
     
-    void exe_update();   // graphics thread
+    void exe_update(float delta_time);   // graphics thread
+    void move_gobjects(float delta_time);   // graphics thread
+    void apply_tweens(float delta_time);   // graphics thread
+    void apply_shared_scene();   // graphics thread
+    void update_transforms();   // graphics thread
+    void bake_unmoved_gobjects();   // graphics thread
     void render();   // graphics thread
+    void render_software();   // graphics thread
+    void fulfil_captures();   // graphics thread (after rendering, before swapping)
     void set_background();   // graphics thread
     void render_gobjects();   // graphics thread
+    void flush_batches();   // graphics thread
+    void render_pick_pass();   // graphics thread
+    void run_exports();   // graphics thread
+    glm::vec2 get_pixel_scale();   // graphics thread (window coordinates -> framebuffer pixels)
+    std::optional< gobj_type > get_gobj_type(GShape& shape);   // graphics thread (by shared mesh)
+    std::shared_ptr< GMesh > get_unit_mesh(gobj_type type);   // graphics thread (created on first use)
+    void sync_window_size();   // graphics thread only (for the render thread)
+    void render_loop();   // render thread
+    void apply_inbox();   // render thread (or graphics thread after joining it)
   };
   
   
@@ -145,18 +317,34 @@ private:
   class Manager{    
   public:
     static Manager& get_instance();
-    bool win_got_closed(id id);
-    std::size_t get_count();
-    static void push_msg_from_API(const Thread_Message& msg);
-    static void process_msgs_to_API();
+    bool win_got_closed(id id);   // lock-free
+    std::size_t get_count();   // lock-free
+    bool wait_lifecycle(const std::function< bool() >& done, std::chrono::milliseconds timeout);
+    int get_lifecycle_fd();
+    void on_input(const Input_Event& event);   // graphics thread (GLFW callbacks)
+    std::size_t poll_events(std::span< Input_Event > events);   // one API thread
+    int get_input_fd();
+    static void push_msg_from_API(const Thread_Message& msg);   // from the graphics thread: same as push_msg_internal()
+    void push_msg_internal(const Thread_Message& msg);   // graphics thread (ignores capacity)
+    static Command_Buffer& get_command_buffer();   // calling thread
+    void push_msgs_from_API(std::vector< Thread_Message >& msgs);   // removes sent messages
     static id get_next_win_id();
     static id get_next_gobj_id();
-    static std::shared_ptr< GShape > new_gobject(gobj_type g_type, float size, glm::vec3 colour);
-    static std::shared_ptr< GShape > new_gobject(gobj_type g_type, glm::vec3 position, float size, glm::vec3 colour);
-    static std::shared_ptr< GShape > new_gobject(gobj_type g_type, glm::vec3 position, float rotation, float size, glm::vec3 colour);
+    static void reserve_ids(const Thread_Message& msg);   // replays: later get_next_*_id() calls skip the recorded ids
+    void publish_render_stats(id win_id, const Render_Stats& stats);   // graphics thread
+    Render_Stats get_render_stats(id win_id);
+    void set_queue_capacity(std::size_t capacity, queue_policy policy);
+    Queue_Stats get_queue_stats();
+    void start_recording(const std::string& path);
+    void stop_recording();
+    void set_headless(bool b);
+    bool is_headless();
+    bool has_glfw();
+    Job_System& get_jobs();   // graphics thread & render threads
+    void exe_msg(Thread_Message& msg);   // graphics thread or render thread of the target window
     
-    thread_msg_queue messages_from_API;   // both threads
-    thread_msg_queue messages_to_API;   // both threads
+    bounded_msg_queue messages_from_API;   // both threads
+    render_stats_table render_stats;   // both threads
     
   private:
     // Meyer's singleton
@@ -170,12 +358,14 @@ private:
     void thread_loop();   // graphics thread
     void update_windows();   // graphics thread
     void wait_until_next_frame();   // graphics thread
-    void push_msg_to_API(const Thread_Message& msg);   // graphics thread
+    void notify_lifecycle();   // graphics thread
+    static bool drop_msgs(bounded_msg_queue& queue);   // both threads (call with queue locked)
     void process_msgs_from_API();   // graphics thread
-    void process_msg(Thread_Message& msg);   // both threads
-    void add_win(id win_id, const std::string& name);   // graphics thread
+    void process_coalesced_msgs();   // graphics thread
+    void process_msg(Thread_Message& msg);   // graphics thread
+    void add_win(id win_id, const std::string& name, render_backend backend);   // graphics thread
     void close_win(id id);   // graphics thread
-    void add_new_gobject(id win_id, id gobj_id, std::shared_ptr< GShape > obj);   // graphics thread
+    void add_new_gobject(id win_id, id gobj_id, const GObject_Descriptor& desc);   // graphics thread
     void remove_gobject(id win_id, id gobj_id);   // graphics thread
     void clear_gobjects(id win_id);   // graphics thread
     void set_gobj_position(id win_id, id gobj_id, glm::vec3 position);   // graphics thread
@@ -185,18 +375,64 @@ private:
     void mod_camera_zoom(id win_id, float zoom_diff);   // graphics thread
     void set_allow_zoom(id win_id, bool b);   // graphics thread
     void set_allow_camera_movement(id win_id, bool b);   // graphics thread
+    void set_camera_inertia(id win_id, bool b);   // graphics thread
     void set_background_colour(id win_id, glm::vec3 colour);   // graphics thread
     void set_window_name(id win_id, const std::string& name);   // graphics thread
-    std::optional< std::shared_ptr< Wrapper > > safe_get_window(id win_id);   // graphics thread
+    void set_render_thread(id win_id, bool b);   // graphics thread
+    void add_polyline(id win_id, id line_id, float thickness, glm::vec3 colour, std::size_t capacity);   // graphics thread
+    void append_points(id win_id, id line_id, const std::vector< glm::vec2 >& points);   // graphics thread
+    void add_point_set(id win_id, id set_id, std::shared_ptr< const Point_Data > data);   // graphics thread
+    void update_points(id win_id, id set_id, std::shared_ptr< const Point_Data > data);   // graphics thread
+    void set_gobj_static(id win_id, id gobj_id, bool b);   // graphics thread
+    void set_auto_static(id win_id, std::size_t frames);   // graphics thread
+    void set_gobj_layer(id win_id, id gobj_id, int layer);   // graphics thread
+    void add_image(id win_id, id image_id, std::shared_ptr< const Image_Data > image);   // graphics thread
+    void add_sprite(id win_id, id sprite_id, const Sprite_Descriptor& desc);   // graphics thread
+    void add_text(id win_id, id text_id, const Text_Descriptor& desc);   // graphics thread
+    void animate(id win_id, id gobj_id, const Tween_Descriptor& desc);   // graphics thread
+    void set_gobj_velocity(id win_id, id gobj_id, glm::vec2 velocity);   // graphics thread
+    void set_gobj_acceleration(id win_id, id gobj_id, glm::vec2 acceleration);   // graphics thread
+    void set_gobj_angular_velocity(id win_id, id gobj_id, float angular_velocity);   // graphics thread
+    void add_group(id win_id, id group_id, glm::vec3 position, float rotation);   // graphics thread
+    void set_gobj_parent(id win_id, id gobj_id, id parent_id);   // graphics thread
+    void remove_gobj_parent(id win_id, id gobj_id);   // graphics thread
+    void share_scene(id win_id, std::shared_ptr< Shared_Scene > scene);   // graphics thread
+    void pick(id win_id, std::shared_ptr< Pick_Request > request);   // graphics thread
+    void export_image(id win_id, std::shared_ptr< Export_Request > request);   // graphics thread
+    void save_snapshot(id win_id, std::shared_ptr< Snapshot_Request > request);   // graphics thread
+    void load_snapshot(id win_id, std::shared_ptr< Scene_Snapshot > snapshot);   // graphics thread
+    void capture(id win_id, std::shared_ptr< Capture_Request > request);   // graphics thread
+    void set_text(id win_id, id text_id, const std::string& text);   // graphics thread
+    std::optional< std::shared_ptr< Wrapper > > safe_get_window(id win_id);   // graphics thread & render threads
+    static std::optional< id > get_win_id(const Thread_Message& msg);   // empty if not window specific
+    static void raise_counter(std::atomic< id >& counter, id value);   // lock-free max
 
-    id next_win_id = 0;
-    id next_gobj_id = 0;
+    static constexpr id gobj_id_block = 256;   // ids reserved per thread at once
+    
+    std::atomic< id > next_win_id = 0;
+    std::atomic< id > next_gobj_id = 0;
     std::thread graphics_thread;
     std::atomic< bool > stop_thread = false;   // both threads
     std::chrono::steady_clock::time_point prev_time;   // graphics thread
+    std::chrono::steady_clock::time_point prev_frame_start = std::chrono::steady_clock::now();   // graphics thread
+    float frame_delta = 0.0f;   // graphics thread (seconds between the last two frames)
     const uint fps = 60;   // graphics thread
-    std::size_t window_count = 0;
-    std::unordered_map< id, bool > got_closed;
-    std::unordered_map< id, std::shared_ptr< Wrapper > > windows;   // graphics thread
+    Message_Coalescer coalescer;   // graphics thread
+    Job_System jobs;   // graphics thread & render threads (per-frame CPU work of all windows)
+    std::shared_ptr< Command_Recorder > recorder;   // both threads (guarded by messages_from_API.mutex)
+    std::atomic< bool > headless = false;   // both threads (applies to windows opened afterwards)
+    bool glfw_ready = false;   // set before the graphics thread starts (false -> only software windows)
+    static constexpr id closed_segment_size = 65536;   // window ids per segment of closed bits (8 KiB)
+    static constexpr id max_windows = closed_segment_size * 16384;   // per process (ids aren't reused; segments are allocated on first use)
+    
+    std::atomic< std::size_t > window_count = 0;   // both threads (open_win sent & window not closed yet)
+    std::array< std::atomic< std::atomic< std::uint64_t >* >, max_windows / closed_segment_size > closed_segments = {};   // both threads (one bit per window id; published by graphics thread)
+    std::mutex lifecycle_mutex;   // both threads (only for waiting)
+    std::condition_variable lifecycle_changed;   // both threads
+    int lifecycle_fd = -1;   // eventfd; counts opened/closed windows
+    Input_Ring input_events;   // graphics thread -> one API thread
+    int input_fd = -1;   // eventfd; counts input events
+    std::unordered_map< id, std::shared_ptr< Wrapper > > windows;   // graphics thread (render threads read through safe_get_window())
+    std::shared_mutex windows_mutex;   // graphics thread writes, render threads read
   };
 };
\ No newline at end of file